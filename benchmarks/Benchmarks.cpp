@@ -0,0 +1,501 @@
+/**
+ * @file Benchmarks.cpp Times the core operations of the ecs system.
+ * Usage: EntityComponentSystem2022Benchmarks [--entities 1000,5000] [--repetitions 3] [--format csv|json]
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#include "Ecs.h"
+
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    /** A component that is Size bytes large. */
+    template<uint64_t Size>
+    struct Payload
+    {
+        std::array<uint8_t, Size> bytes {};
+    };
+
+    struct Position { float x { 0.f }, y { 0.f }, z { 0.f }; };
+    struct Velocity { float x { 1.f }, y { 1.f }, z { 1.f }; };
+
+    /** Used to split entities into different archetypes. */
+    template<uint64_t Index>
+    struct Tag { uint8_t value { 0 }; };
+
+    /** A component that no entity ever has. */
+    struct Unused { uint8_t value { 0 }; };
+
+    /** Stops the compiler from removing work that has no visible side effects. */
+    volatile uint64_t sink { 0 };
+
+    struct Settings
+    {
+        std::vector<uint64_t>   entityCounts    { 1000, 5000 };
+        uint64_t                repetitions     { 3 };
+        bool                    json            { false };
+    };
+
+    struct Result
+    {
+        std::string name;
+        uint64_t    entityCount     { 0 };
+        uint64_t    componentSize   { 0 };
+        uint64_t    operations      { 0 };
+        int64_t     nanoseconds     { 0 };
+    };
+
+    /**
+     * @brief Times a single run of a benchmark.
+     */
+    class Timer
+    {
+    public:
+        void start() { mStart = Clock::now(); }
+        void stop() { mElapsed += Clock::now() - mStart; }
+        [[nodiscard]] int64_t nanoseconds() const { return std::chrono::duration_cast<std::chrono::nanoseconds>(mElapsed).count(); }
+
+    protected:
+        Clock::time_point   mStart;
+        Clock::duration     mElapsed { 0 };
+    };
+
+    template<typename T>
+    class TouchSystem
+        : public ecs::BaseSystem<T>
+    {
+    public:
+        TouchSystem()
+        {
+            this->mEntities.forEach([](T &value) { ++value.bytes[0]; });
+        }
+    };
+
+    template<typename T>
+    class MoveSystem
+        : public ecs::BaseSystem<Position, Velocity, T>
+    {
+    public:
+        MoveSystem()
+        {
+            this->mEntities.forEach([](Position &position, const Velocity &velocity, T &value) {
+                position.x += velocity.x;
+                position.y += velocity.y;
+                position.z += velocity.z;
+                ++value.bytes[0];
+            });
+        }
+    };
+
+    /** The same as MoveSystem, but the work is in onEntity() so that a Pipeline can inline it. */
+    template<typename T>
+    class InlineMoveSystem
+        : public ecs::BaseSystem<Position, Velocity, T>
+    {
+    public:
+        void onEntity(Position &position, const Velocity &velocity, T &value)
+        {
+            position.x += velocity.x;
+            position.y += velocity.y;
+            position.z += velocity.z;
+            ++value.bytes[0];
+        }
+    };
+
+    class PositionSystem
+        : public ecs::BaseSystem<Position>
+    {
+    public:
+        PositionSystem()
+        {
+            mEntities.forEach([](Position &position) { position.x += 1.f; });
+        }
+    };
+
+    class EmptySystem
+        : public ecs::BaseSystem<Unused>
+    {
+    };
+
+    std::vector<ecs::Entity> createEntities(ecs::Core &core, uint64_t count)
+    {
+        std::vector<ecs::Entity> entities(count);
+        for (ecs::Entity &entity : entities)
+            entity = core.create();
+        return entities;
+    }
+
+    template<typename T>
+    uint64_t benchmarkCreate(ecs::Core &core, uint64_t count, Timer &timer)
+    {
+        timer.start();
+        for (uint64_t i = 0; i < count; ++i)
+            sink = sink + core.create();
+        timer.stop();
+        return count;
+    }
+
+    template<typename T>
+    uint64_t benchmarkAdd(ecs::Core &core, uint64_t count, Timer &timer)
+    {
+        const std::vector<ecs::Entity> entities = createEntities(core, count);
+
+        timer.start();
+        for (const ecs::Entity entity : entities)
+            core.add(entity, T());
+        timer.stop();
+        return count;
+    }
+
+    template<typename T>
+    uint64_t benchmarkAddTransition(ecs::Core &core, uint64_t count, Timer &timer)
+    {
+        const std::vector<ecs::Entity> entities = createEntities(core, count);
+        for (const ecs::Entity entity : entities)
+            core.add(entity, Position());
+
+        timer.start();
+        for (const ecs::Entity entity : entities)
+            core.add(entity, T());
+        timer.stop();
+        return count;
+    }
+
+    template<typename T>
+    uint64_t benchmarkRemoveTransition(ecs::Core &core, uint64_t count, Timer &timer)
+    {
+        const std::vector<ecs::Entity> entities = createEntities(core, count);
+        for (const ecs::Entity entity : entities)
+        {
+            core.add(entity, Position());
+            core.add(entity, T());
+        }
+
+        const ecs::Component component = core.get<T>();
+        timer.start();
+        for (const ecs::Entity entity : entities)
+            core.remove(entity, component);
+        timer.stop();
+        return count;
+    }
+
+    template<typename T>
+    uint64_t benchmarkDestroy(ecs::Core &core, uint64_t count, Timer &timer)
+    {
+        const std::vector<ecs::Entity> entities = createEntities(core, count);
+        for (const ecs::Entity entity : entities)
+        {
+            core.add(entity, Position());
+            core.add(entity, T());
+        }
+
+        timer.start();
+        for (const ecs::Entity entity : entities)
+            core.destroy(entity);
+        timer.stop();
+        return count;
+    }
+
+    template<typename T>
+    uint64_t benchmarkRandomGet(ecs::Core &core, uint64_t count, Timer &timer)
+    {
+        std::vector<ecs::Entity> entities = createEntities(core, count);
+        for (const ecs::Entity entity : entities)
+            core.add(entity, T());
+
+        std::shuffle(entities.begin(), entities.end(), std::mt19937_64(count));
+
+        timer.start();
+        uint64_t sum = 0;
+        for (const ecs::Entity entity : entities)
+            sum += core.getComponent<T>(entity).bytes[0];
+        timer.stop();
+
+        sink = sink + sum;
+        return count;
+    }
+
+    template<typename T>
+    uint64_t benchmarkRandomGetValidated(ecs::Core &core, uint64_t count, Timer &timer)
+    {
+        // The same as get_random, but with a plain Component so that its type is checked on every access.
+        const ecs::Component component = core.get<T>();
+        std::vector<ecs::Entity> entities = createEntities(core, count);
+        for (const ecs::Entity entity : entities)
+            core.add(entity, T());
+
+        std::shuffle(entities.begin(), entities.end(), std::mt19937_64(count));
+
+        timer.start();
+        uint64_t sum = 0;
+        for (const ecs::Entity entity : entities)
+            sum += core.getComponent<T>(entity, component).bytes[0];
+        timer.stop();
+
+        sink = sink + sum;
+        return count;
+    }
+
+    template<typename T>
+    uint64_t benchmarkForEach(ecs::Core &core, uint64_t count, Timer &timer)
+    {
+        core.createSystem<TouchSystem<T>>();
+        for (const ecs::Entity entity : createEntities(core, count))
+            core.add(entity, T());
+
+        const uint64_t frames = 10;
+        timer.start();
+        for (uint64_t i = 0; i < frames; ++i)
+            core.update();
+        timer.stop();
+        return count * frames;
+    }
+
+    template<typename T>
+    uint64_t benchmarkForEachMulti(ecs::Core &core, uint64_t count, Timer &timer)
+    {
+        core.createSystem<MoveSystem<T>>();
+        for (const ecs::Entity entity : createEntities(core, count))
+        {
+            core.add(entity, Position());
+            core.add(entity, Velocity());
+            core.add(entity, T());
+        }
+
+        const uint64_t frames = 10;
+        timer.start();
+        for (uint64_t i = 0; i < frames; ++i)
+            core.update();
+        timer.stop();
+        return count * frames;
+    }
+
+    template<typename T>
+    uint64_t benchmarkPipelineForEachMulti(ecs::Core &core, uint64_t count, Timer &timer)
+    {
+        // The same work as for_each_multi, but through a Pipeline instead of Core::update().
+        for (const ecs::Entity entity : createEntities(core, count))
+        {
+            core.add(entity, Position());
+            core.add(entity, Velocity());
+            core.add(entity, T());
+        }
+        ecs::Pipeline<InlineMoveSystem<T>> pipeline(core);
+
+        const uint64_t frames = 10;
+        timer.start();
+        for (uint64_t i = 0; i < frames; ++i)
+            pipeline.update();
+        timer.stop();
+        return count * frames;
+    }
+
+    template<typename T>
+    uint64_t benchmarkStaticForEachMulti(ecs::Core &, uint64_t count, Timer &timer)
+    {
+        // The same work as for_each_multi, but on a StaticWorld.
+        ecs::StaticWorld<ecs::Archetypes<ecs::Signature<Position, Velocity, T>>> world;
+        world.template reserve<Position, Velocity, T>(count);
+        std::vector<ecs::StaticEntity> entities;
+        for (uint64_t i = 0; i < count; ++i)
+            entities.push_back(world.create(Position(), Velocity(), T()));
+
+        const uint64_t frames = 10;
+        timer.start();
+        for (uint64_t i = 0; i < frames; ++i)
+        {
+            world.template forEach<Position, Velocity, T>([](Position &position, const Velocity &velocity, T &value) {
+                position.x += velocity.x;
+                position.y += velocity.y;
+                position.z += velocity.z;
+                ++value.bytes[0];
+            });
+        }
+        timer.stop();
+
+        sink = sink + world.template get<T>(entities.back()).bytes[0];
+        return count * frames;
+    }
+
+    template<uint64_t ...Indices>
+    void addTag(ecs::Core &core, ecs::Entity entity, uint64_t tag, std::integer_sequence<uint64_t, Indices...>)
+    {
+        using AddFunction = void(*)(ecs::Core&, ecs::Entity);
+        static constexpr AddFunction functions[] = {
+            [](ecs::Core &c, ecs::Entity e) { c.add(e, Tag<Indices>()); }...
+        };
+        functions[tag](core, entity);
+    }
+
+    template<typename T>
+    uint64_t benchmarkManyArchetypes(ecs::Core &core, uint64_t count, Timer &timer)
+    {
+        constexpr uint64_t archetypeCount = 32;
+
+        core.createSystem<PositionSystem>();
+        const std::vector<ecs::Entity> entities = createEntities(core, count);
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            core.add(entities[i], Position());
+            addTag(core, entities[i], i % archetypeCount, std::make_integer_sequence<uint64_t, archetypeCount>());
+        }
+
+        const uint64_t frames = 10;
+        timer.start();
+        for (uint64_t i = 0; i < frames; ++i)
+            core.update();
+        timer.stop();
+        return count * frames;
+    }
+
+    template<typename T>
+    uint64_t benchmarkSystemDispatch(ecs::Core &core, uint64_t count, Timer &timer)
+    {
+        // Count is the number of systems here, none of which have any entities to process.
+        for (uint64_t i = 0; i < count; ++i)
+            core.createSystem<EmptySystem>();
+
+        const uint64_t frames = 10;
+        timer.start();
+        for (uint64_t i = 0; i < frames; ++i)
+            core.update();
+        timer.stop();
+        return count * frames;
+    }
+
+    using Benchmark = std::function<uint64_t(ecs::Core&, uint64_t, Timer&)>;
+
+    /**
+     * @brief Runs benchmark repetition times on a fresh Core each time and keeps the fastest.
+     */
+    Result run(const std::string &name, const Benchmark &benchmark, uint64_t count, uint64_t componentSize, uint64_t repetitions)
+    {
+        Result result { name, count, componentSize, 0, std::numeric_limits<int64_t>::max() };
+        for (uint64_t i = 0; i < repetitions; ++i)
+        {
+            ecs::Core core(ecs::initFlag::AutoInitialise);
+            Timer timer;
+            result.operations = benchmark(core, count, timer);
+            result.nanoseconds = std::min(result.nanoseconds, timer.nanoseconds());
+        }
+        return result;
+    }
+
+    template<uint64_t Size>
+    void runSized(const Settings &settings, std::vector<Result> &results)
+    {
+        using T = Payload<Size>;
+        const std::pair<const char*, Benchmark> benchmarks[] = {
+            { "create",                  benchmarkCreate<T> },
+            { "add",                     benchmarkAdd<T> },
+            { "add_transition",          benchmarkAddTransition<T> },
+            { "remove_transition",       benchmarkRemoveTransition<T> },
+            { "destroy",                 benchmarkDestroy<T> },
+            { "get_random",              benchmarkRandomGet<T> },
+            { "get_random_validated",    benchmarkRandomGetValidated<T> },
+            { "for_each_single",         benchmarkForEach<T> },
+            { "for_each_multi",          benchmarkForEachMulti<T> },
+            { "pipeline_for_each_multi", benchmarkPipelineForEachMulti<T> },
+            { "static_for_each_multi",   benchmarkStaticForEachMulti<T> },
+        };
+
+        for (const uint64_t count : settings.entityCounts)
+        {
+            for (const auto &[name, benchmark] : benchmarks)
+                results.push_back(run(name, benchmark, count, Size, settings.repetitions));
+        }
+    }
+
+    void runUnsized(const Settings &settings, std::vector<Result> &results)
+    {
+        for (const uint64_t count : settings.entityCounts)
+        {
+            results.push_back(run("many_archetypes", benchmarkManyArchetypes<Position>, count, sizeof(Position), settings.repetitions));
+
+            // The number of systems does not need to scale with the number of entities.
+            const uint64_t systemCount = std::min<uint64_t>(count, 1000);
+            results.push_back(run("system_dispatch", benchmarkSystemDispatch<Unused>, systemCount, 0, settings.repetitions));
+        }
+    }
+
+    void write(const std::vector<Result> &results, bool json)
+    {
+        if (!json)
+            std::cout << "benchmark,entities,component_bytes,operations,total_ns,ns_per_op\n";
+
+        for (const Result &result : results)
+        {
+            const double perOperation = result.operations == 0
+                ? 0.0 : static_cast<double>(result.nanoseconds) / static_cast<double>(result.operations);
+
+            if (json)
+            {
+                std::cout << "{\"benchmark\":\"" << result.name << "\",\"entities\":" << result.entityCount
+                          << ",\"component_bytes\":" << result.componentSize << ",\"operations\":" << result.operations
+                          << ",\"total_ns\":" << result.nanoseconds << ",\"ns_per_op\":" << perOperation << "}\n";
+            }
+            else
+            {
+                std::cout << result.name << "," << result.entityCount << "," << result.componentSize << ","
+                          << result.operations << "," << result.nanoseconds << "," << perOperation << "\n";
+            }
+        }
+    }
+
+    Settings parse(int argc, char *argv[])
+    {
+        Settings settings;
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string argument = argv[i];
+            const bool hasValue = i + 1 < argc;
+            if (argument == "--entities" && hasValue)
+            {
+                settings.entityCounts.clear();
+                std::stringstream stream(argv[++i]);
+                for (std::string count; std::getline(stream, count, ',');)
+                    settings.entityCounts.push_back(std::stoull(count));
+            }
+            else if (argument == "--repetitions" && hasValue)
+                settings.repetitions = std::max<uint64_t>(1, std::stoull(argv[++i]));
+            else if (argument == "--format" && hasValue)
+                settings.json = std::strcmp(argv[++i], "json") == 0;
+            else
+            {
+                std::cerr << "Usage: " << argv[0] << " [--entities 1000,5000] [--repetitions 3] [--format csv|json]\n";
+                std::exit(1);
+            }
+        }
+        return settings;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    const Settings settings = parse(argc, argv);
+
+    std::vector<Result> results;
+    runSized<4>(settings, results);
+    runSized<64>(settings, results);
+    runSized<256>(settings, results);
+    runUnsized(settings, results);
+
+    write(results, settings.json);
+    return 0;
+}
@@ -11,7 +11,9 @@
 #include <vector>
 #include <string>
 #include <set>
+#include <tuple>
 #include <algorithm>
+#include <type_traits>
 
 /** An Entity ID that can be used to get data from the Entity Component System */
 typedef uint64_t                Entity;
@@ -39,6 +41,23 @@ namespace ecs
     /** The type that an entity is (identical to UComponentVector) @see UComponentVector */
     typedef UComponentVector        UType;
     
+    /** A unique number for each type, handed out in the order that types are first used. Replaces typeid. */
+    typedef uint64_t                TypeIndex;
+    
+    class Archetype;
+    
+    /**
+     * @brief The archetypes that match a type. Only archetypes created since the last look-up are checked, so that
+     * nothing is allocated once every archetype exists.
+     */
+    struct ArchetypeCache
+    {
+        std::vector<Archetype*> archetypes;
+        
+        /** The number of archetypes (in creation order) that have already been checked. */
+        uint64_t checkedCount { 0 };
+    };
+    
     namespace initFlag
     {
         enum init : int
@@ -110,6 +129,71 @@ namespace ecs
         PreFixedUpdate, FixedUpdate, PreUpdate, Update, PreRender, Render, ImGui
     };
     
+    /**
+     * @brief Hands out the next type index. Use typeIndexOf<T>() instead.
+     * @returns A number that has not been handed out before.
+     */
+    TypeIndex nextTypeIndex();
+    
+    /**
+     * @brief Gets the index of type T without RTTI. Cv qualifiers are ignored (the same as typeid).
+     * Indices are dense (starting at 0) so they can be used to index into arrays.
+     * @tparam T - The type you want the index of.
+     * @returns The same number every time it is called with T.
+     */
+    template<typename T>
+    TypeIndex typeIndexOf()
+    {
+        if constexpr (!std::is_same_v<std::remove_cv_t<T>, T>)
+        {
+            return typeIndexOf<std::remove_cv_t<T>>();
+        }
+        else
+        {
+            static const TypeIndex index = nextTypeIndex();
+            return index;
+        }
+    }
+    
+    /**
+     * @brief A component Id that remembers the type it was created with, so that mismatches are caught at compile
+     * time. Converts to a plain Component wherever one is expected.
+     * @tparam T - The type of the component.
+     */
+    template<typename T>
+    struct ComponentId
+    {
+        Component id { 0 };
+        
+        operator Component() const { return id; }
+    };
+    
+    /**
+     * @brief Whether T is a component Id rather than a component value. Every integer counts, since Component is one.
+     * @tparam T - The type you want to check. Decay it first.
+     */
+    template<typename T>
+    struct isComponentId : std::is_integral<T> {};
+    
+    template<typename T>
+    struct isComponentId<ComponentId<T>> : std::true_type {};
+    
+    /** A UType where every component Id is typed. E.g.: TypedUType<Position, Velocity>. */
+    template<typename ...Ts>
+    using TypedUType = std::tuple<ComponentId<Ts>...>;
+    
+    /**
+     * @brief Makes a TypedUType from typed component Ids, so the types are deduced from the Ids themselves. A braced
+     * list (E.g.: { posId, velId }) cannot be deduced and becomes an unchecked UType instead.
+     * @param ids - The component Ids, in order. E.g.: makeTypedUType(posId, velId) => TypedUType<Position, Velocity>.
+     * @returns A TypedUType of ids.
+     */
+    template<typename ...Ts>
+    TypedUType<Ts...> makeTypedUType(ComponentId<Ts> ...ids)
+    {
+        return { ids... };
+    }
+    
     /**
      * @brief Checks to see if the subset is wholly contained within set.
      * @param set - The set you want to check in. E.g.: (A, B, C, D)
@@ -0,0 +1,51 @@
+/**
+ * @file ComponentLayout.h Describes components that are defined at runtime (E.g.: by designers or a scripting
+ * language), so that they can be stored without a C++ type.
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ecs
+{
+    /**
+     * @brief A single named field within a runtime component. Only used to describe the component to tools and
+     * scripts. The ecs system never reads it.
+     */
+    struct FieldLayout
+    {
+        std::string name;
+        uint64_t    offset  { 0 };
+        uint64_t    size    { 0 };
+    };
+
+    /**
+     * @brief Everything that the ecs system needs to store a component that has no C++ type.
+     * Components are moved between archetypes byte by byte, so they must not point into themselves.
+     */
+    struct ComponentLayout
+    {
+        /** Only used for debugging and tools. */
+        std::string name;
+
+        uint64_t size       { 0 };
+
+        /** Must be a power of two. */
+        uint64_t alignment  { alignof(std::max_align_t) };
+
+        std::vector<FieldLayout> fields;
+
+        /** Called on new components that are not given a value. The component is zeroed if this is nullptr. */
+        void (*construct)(void *component) { nullptr };
+
+        /** Called when a component is removed or destroyed. Nothing is called if this is nullptr. */
+        void (*destruct)(void *component) { nullptr };
+    };
+}
@@ -8,17 +8,48 @@
 #pragma once
 
 #include "Common.h"
+#include "ComponentLayout.h"
+#include "GrowthPolicy.h"
+#include "ScratchAllocator.h"
+#include "Query.h"
 #include "EntityManager.h"
 #include "components/ArchetypeManager.h"
 #include "systems/SystemManager.h"
-#include "Entities.h"
+#include "Statistics.h"
+#include "PerfCounters.h"
+#include "WorkloadRecorder.h"
+#include "LatencyHistogram.h"
+#include "StatsExporter.h"
 
 #include <unordered_map>
-#include <typeinfo>
 #include <memory>
+#include <ostream>
+#include <array>
+#include <chrono>
+#include <functional>
+#include <atomic>
+#include <mutex>
+#include <thread>
 
 namespace ecs
 {
+    /** Called when a phase takes longer than its budget. Given the phase and how long it took. */
+    typedef std::function<void(phase::phase, std::chrono::nanoseconds)> PhaseBudgetCallback;
+    
+    /**
+     * @brief Writes everything that has been traced so far in Chrome's trace_event JSON format. Open it with
+     * chrome://tracing or ui.perfetto.dev. Events are only recorded when built with ECS_ENABLE_TRACING.
+     * NOTE: Tracing is process-wide. Events from every Core (and every thread) are written together.
+     * @param stream - The stream that you want to write the trace to (E.g.: an std::ofstream).
+     */
+    void writeTrace(std::ostream &stream);
+    
+    /**
+     * @brief Removes every event that has been traced so far, from every Core. No thread may be running a Core while
+     * this is called.
+     */
+    void clearTrace();
+    
     /**
      * The 'core' of the Entity Component System. Allows you to create Entities that are used for Ids for Components.
      * Components typically C style structs that contain purely data. Systems then manipulate on components.
@@ -43,15 +74,30 @@ namespace ecs
          * @returns The id given to component T.
          */
         template<typename T>
-        Component create(creationType flag=Default);
+        ComponentId<T> create(creationType flag=Default);
+        
+        /**
+         * @brief Creates a component from a layout that is only known at runtime. THROWS if the alignment is not a
+         * power of two. Every call creates a new type, even when the layouts are the same.
+         * @param layout - How the component is laid out. It is copied.
+         * @returns The id given to the component.
+         */
+        Component create(const ComponentLayout &layout);
+        
+        /**
+         * @brief Gets the layout that a component was created with. THROWS if it was not created with a layout.
+         * @param component - The component Id.
+         * @returns The layout of component.
+         */
+        [[nodiscard]] const ComponentLayout &getLayout(Component component) const;
     
         /**
          * @brief Checks to see if the uType and the underlying types match within the system. THROWS if there's an error.
-         * uType[i] MUST pair with underlyingTypeHashes[i].
+         * uType[i] MUST pair with underlyingTypes[i].
          * @param uType - The components that you want to check.
-         * @param underlyingTypeHashes - The hash codes of each actual type.
+         * @param underlyingTypes - The type index (typeIndexOf()) of each actual type.
          */
-        void verifySystem(const UType &uType, const std::vector<uint64_t> &underlyingTypeHashes);
+        void verifySystem(const UType &uType, const std::vector<TypeIndex> &underlyingTypes);
     
         /**
          * @brief Creates a system that can be used within the ecs system.
@@ -63,6 +109,19 @@ namespace ecs
         template<typename System, typename ...Args>
         void createSystem(const UType &uType, Args &&...args);
     
+        /**
+         * @brief Creates a system that can be used within the ecs system. The types of uType are checked against
+         * the system at compile time, so nothing is verified at runtime.
+         * @tparam System - The type of system. MUST inherit from base system.
+         * @tparam Ts - The type of each component. MUST match the types of the system, in order.
+         * @tparam Args - The type of args passed to the constructor of the system.
+         * @param uType - The components that you want this system to operate on.
+         * E.g.: makeTypedUType(core.create<Position>(), core.create<Velocity>()).
+         * @param args - The arguments passed into the systems constructor.
+         */
+        template<typename System, typename ...Ts, typename ...Args>
+        void createSystem(TypedUType<Ts...> uType, Args &&...args);
+    
         /**
          * @brief Creates a system that can be used within the ecs system.
          * @tparam System - The type of system. MUST inherit from base system.
@@ -82,14 +141,111 @@ namespace ecs
         template<typename T>
         void add(Entity eId, Component cId, const T &value);
     
+        /**
+         * @brief Adds a component to the specified entity by moving value into it. Only takes a plain Component, so
+         * that a ComponentId<T> always goes to the overloads that check its type.
+         * @tparam T - The type you want to give to value. Only rvalues are taken.
+         * @tparam C - The type of cId. Must be an integer (E.g.: Component).
+         * @param eId - The entity Id that you want to give the component to.
+         * @param cId - The component Id of T.
+         * @param value - The actual data assigned to entity.
+         */
+        template<typename T, typename C,
+                 typename = std::enable_if_t<std::is_integral_v<C> && !std::is_lvalue_reference_v<T>>>
+        void add(Entity eId, C cId, T &&value);
+    
         /**
          * @brief Adds a component to the specified entity.
          * @tparam T - The type you want to give to value.
          * @param eId - The entity Id that you want to give the component to.
+         * @param cId - The component Id of T.
+         * @param value - The actual data assigned to entity.
+         */
+        template<typename T>
+        void add(Entity eId, ComponentId<T> cId, const T &value);
+    
+        /**
+         * @brief Adds a component to the specified entity by moving value into it.
+         * @tparam T - The type you want to give to value.
+         * @param eId - The entity Id that you want to give the component to.
+         * @param cId - The component Id of T.
+         * @param value - The actual data assigned to entity.
+         */
+        template<typename T>
+        void add(Entity eId, ComponentId<T> cId, T &&value);
+        
+        /** @brief Fails to compile when the component Id was created with a different type to value. */
+        template<typename T, typename U>
+        void add(Entity eId, ComponentId<U> cId, const T &value) = delete;
+    
+        /**
+         * @brief Adds a component to the specified entity. value is moved if it is an rvalue.
+         * @tparam T - The type you want to give to value.
+         * @param eId - The entity Id that you want to give the component to.
          * @param value - The actual data assigned to entity.
          */
         template<typename T>
-        void add(Entity eId, const T &value);
+        void add(Entity eId, T &&value);
+        
+        /**
+         * @brief Adds several components to the specified entity in a single move between archetypes. Each is moved
+         * if it is an rvalue. THROWS if the entity already has one of them or a type is given twice.
+         * Never chosen when one of the arguments is a component Id, so add(eId, cId, value) always adds one component.
+         * @tparam A, B, Ts - The type of each component. Their default component Ids are used.
+         * @param eId - The entity Id that you want to give the components to.
+         * @param a, b, values - The actual data assigned to entity.
+         */
+        template<typename A, typename B, typename ...Ts,
+                 typename = std::enable_if_t<!(isComponentId<std::decay_t<A>>::value
+                                               || isComponentId<std::decay_t<B>>::value
+                                               || (isComponentId<std::decay_t<Ts>>::value || ...))>>
+        void add(Entity eId, A &&a, B &&b, Ts &&...values);
+        
+        /**
+         * @brief Adds a component to the specified entity by constructing it directly within its new archetype.
+         * Nothing is copied or moved. Aggregates are brace-initialised, E.g.: emplace<Position>(entity, 1.f, 2.f).
+         * @tparam T - The type of component.
+         * @tparam Args - The types of args.
+         * @param eId - The entity Id that you want to give the component to.
+         * @param args - The arguments passed into the constructor of T, or its members in order if T is an aggregate.
+         * @returns The new component. Only valid until the next change.
+         */
+        template<typename T, typename ...Args>
+        T &emplace(Entity eId, Args &&...args);
+        
+        /**
+         * @brief Adds a component to the specified entity by constructing it directly within its new archetype.
+         * Nothing is copied or moved. Aggregates are brace-initialised, E.g.: emplace<Position>(entity, 1.f, 2.f).
+         * @tparam T - The type of component.
+         * @tparam Args - The types of args.
+         * @param eId - The entity Id that you want to give the component to.
+         * @param cId - The component Id of T.
+         * @param args - The arguments passed into the constructor of T, or its members in order if T is an aggregate.
+         * @returns The new component. Only valid until the next change.
+         */
+        template<typename T, typename ...Args>
+        T &emplace(Entity eId, ComponentId<T> cId, Args &&...args);
+        
+        /**
+         * @brief Adds a component that was created with a layout to the specified entity. THROWS if cId was not
+         * created with a layout.
+         * @param eId - The entity Id that you want to give the component to.
+         * @param cId - The component Id.
+         * @param value - The bytes that are copied into the component. Constructed (or zeroed) if nullptr.
+         */
+        void addDynamic(Entity eId, Component cId, const void *value=nullptr);
+        
+        /**
+         * @brief Creates count entities that each have every one of components. Much faster than adding to each
+         * entity separately since they go straight into their archetype. THROWS if a component was not created
+         * with a layout or is given twice.
+         * @param count - The number of entities to create.
+         * @param components - The components that every entity will have. Must have been created with a layout.
+         * @param values - For each component, count values packed layout.size bytes apart. Either can be nullptr to
+         * construct (or zero) them.
+         * @param out - Where the new entities are written. Must have room for count entities.
+         */
+        void spawn(uint64_t count, const UType &components, const void *const *values, Entity *out);
         
         /**
          * @brief Performs an update on every system and entity in the ecs system.
@@ -112,13 +268,46 @@ namespace ecs
         void imGui();
     
         /**
-         * @brief
-         * @tparam EArgs
-         * @param entities
-         * @param uType
+         * @brief Passes every entity that has all of uType into entities.
+         * @tparam EArgs - The types of each component in uType.
+         * @param entities - The entities that you want to invoke.
+         * @param uType - The component Ids that pair with each of EArgs.
+         * @returns The number of entities and archetypes that were processed.
          */
         template<typename ...EArgs>
-        void processEntities(Entities<EArgs...> &entities, const UType &uType);
+        ProcessStatistics processEntities(Entities<EArgs...> &entities, const UType &uType);
+        
+        /**
+         * @brief Passes every entity that has all of uType into function. Called directly, so it can be inlined.
+         * @tparam EArgs - The types of each component in uType.
+         * @param cache - The archetypes that matched uType last time. Use a separate cache for each uType.
+         * @param uType - The component Ids that pair with each of EArgs.
+         * @param function - Called with (EArgs &...) for each entity.
+         * @returns The number of entities and archetypes that were processed.
+         */
+        template<typename ...EArgs, typename Function>
+        ProcessStatistics processEntities(ArchetypeCache &cache, const UType &uType, Function &&function);
+        
+        /**
+         * @brief Creates a query over components that are only known at runtime. Keep it and reuse it, since it
+         * remembers every archetype that it has matched.
+         * @param components - Archetypes must have all of these. Columns are given for each, in this order.
+         * @param with - Archetypes must also have all of these, but no columns are given for them.
+         * @param without - Archetypes must have none of these.
+         * @returns The compiled query.
+         */
+        [[nodiscard]] Query createQuery(const UType &components, const UType &with={}, const UType &without={});
+        
+        /**
+         * @brief Passes the columns of every archetype that matches query (and has at least one entity) into function.
+         * The types of the components do not need to be known, so this works for components created with a layout.
+         * Disabled entities are skipped by splitting an archetype into several chunks.
+         * @param query - A query made with createQuery().
+         * @param function - Called with (const ColumnChunk &) for each run of enabled entities in each archetype.
+         * @returns The number of entities and archetypes that were processed.
+         */
+        template<typename Function>
+        ProcessStatistics forEachChunk(Query &query, Function &&function);
     
         /**
          * @brief Makes the given Id the default id when handling components with the same type.
@@ -132,7 +321,7 @@ namespace ecs
          * @returns A Component Id.
          */
         template<typename T>
-        [[nodiscard]] Component getComponentIdOf();
+        [[nodiscard]] ComponentId<T> getComponentIdOf();
     
         /**
          * @brief Gets the default Component Id assigned to T. (Identical to getComponentIdOf();)
@@ -140,7 +329,7 @@ namespace ecs
          * @returns A component Id.
          */
         template<typename T>
-        [[nodiscard]] Component get();
+        [[nodiscard]] ComponentId<T> get();
     
         /**
          * @brief Gets a reference to a component of type T.
@@ -152,6 +341,21 @@ namespace ecs
         template<typename T>
         [[nodiscard]] T &getComponent(Entity entity, Component component);
     
+        /**
+         * @brief Gets a reference to a component of type T. Does not validate component since its type is already
+         * known to be T.
+         * WARNING: Do not store this value for longer than this function is used.
+         * @tparam T - The type of component you're looking for.
+         * @param entity - The entity that you'd like to query.
+         * @param component - The component Id of T.
+         */
+        template<typename T>
+        [[nodiscard]] T &getComponent(Entity entity, ComponentId<T> component);
+        
+        /** @brief Fails to compile when the component Id was created with a different type to T. */
+        template<typename T, typename U, typename = std::enable_if_t<!std::is_same_v<T, U>>>
+        T &getComponent(Entity entity, ComponentId<U> component) = delete;
+    
         /**
          * @brief Checks to see if an entity has a component.
          * @param entity - The entity that may have component.
@@ -168,6 +372,32 @@ namespace ecs
          */
         template<typename T>
         bool hasComponent(Entity entity);
+        
+        /**
+         * @param entity - The entity that you're querying for.
+         * @returns True if entity was created and has not been destroyed.
+         */
+        [[nodiscard]] bool isValid(Entity entity);
+        
+        /**
+         * @param entity - The entity that you're querying for.
+         * @returns True if entity has at least one component. setEnabled() only works on these entities.
+         */
+        [[nodiscard]] bool hasAnyComponent(Entity entity) const;
+        
+        /**
+         * @brief Stops (or resumes) entity from being iterated over. Unlike removing a marker component, none of the
+         * entity's components are moved. THROWS if the entity doesn't have any components.
+         * @param entity - The entity that you want to enable or disable.
+         * @param enabled - Whether systems and queries should see the entity.
+         */
+        void setEnabled(Entity entity, bool enabled);
+        
+        /**
+         * @param entity - The entity that you're querying for.
+         * @returns False if the entity has been disabled with setEnabled(), true otherwise.
+         */
+        [[nodiscard]] bool isEnabled(Entity entity) const;
     
         /**
          * @brief Gets a reference to a component of type T.
@@ -177,6 +407,14 @@ namespace ecs
          */
         template<typename T>
         [[nodiscard]] T &getComponent(Entity entity);
+        
+        /**
+         * @brief Gets the address of a component without knowing its type. Works for any component.
+         * WARNING: Do not store this value for longer than this function is used.
+         * @param entity - The entity that you'd like to query.
+         * @param component - The component Id.
+         */
+        [[nodiscard]] void *getComponentData(Entity entity, Component component);
     
         /**
          * @brief Removes a component from an entity.
@@ -184,26 +422,284 @@ namespace ecs
          * @param component - The component that you want to remove.
          */
         void remove(Entity entity, Component component);
+        
+        /**
+         * @brief Removes several components from an entity in a single move between archetypes. Components that
+         * entity does not have are ignored.
+         * @param entity - The entity you want to target
+         * @param components - The components that you want to remove.
+         */
+        void remove(Entity entity, const UType &components);
+        
+        /**
+         * @brief Removes the default component of each type from an entity in a single move between archetypes.
+         * Components that entity does not have are ignored.
+         * @tparam T, Ts - The types you want to remove.
+         * @param entity - The entity you want to target
+         */
+        template<typename T, typename ...Ts>
+        void remove(Entity entity);
+        
+        /**
+         * @brief Destroys an entity and all of the components attached to it.
+         * @param entity - The entity that you want to destroy.
+         */
+        void destroy(Entity entity);
+        
+        /**
+         * @brief Makes sure that count entities with exactly signature can be stored without reallocating. THROWS if
+         * no entity has had that signature yet.
+         * @param signature - The components of the archetype.
+         * @param count - The number of entities.
+         */
+        void reserve(const UType &signature, uint64_t count);
+        
+        /**
+         * @brief Makes sure that count entities with exactly the default components of T and Ts can be stored without
+         * reallocating. The archetype is created if it doesn't exist yet.
+         * @tparam T, Ts - The types of the components.
+         * @param count - The number of entities.
+         */
+        template<typename T, typename ...Ts>
+        void reserve(uint64_t count);
+        
+        /**
+         * @brief Sets how the component arrays of every archetype grow when they run out of room, except for those
+         * given their own policy.
+         * @param policy - The policy that you want to use from now on.
+         */
+        void setGrowthPolicy(const GrowthPolicy &policy);
+        
+        /**
+         * @brief Sets how the component arrays of a single archetype grow when they run out of room. THROWS if no
+         * entity has had that signature yet.
+         * @param signature - The components of the archetype.
+         * @param policy - The policy that you want to use from now on.
+         */
+        void setGrowthPolicy(const UType &signature, const GrowthPolicy &policy);
+        
+        /**
+         * @brief Gets the timings of each system over the last few frames. Only recorded when built with
+         * ECS_ENABLE_PROFILING, otherwise this is always empty.
+         * @returns The statistics of each system in the order that they are updated.
+         */
+        [[nodiscard]] std::vector<SystemStatistics> getSystemStatistics() const;
+        
+        /**
+         * @brief Gets the scratch arena of the calling thread, for temporary memory within systems. Everything in it
+         * is freed the first time the thread asks for it after a new phase (fixedUpdate(), update(), render() or
+         * imGui()) has begun. Arenas are only ever reset by their own thread, so a worker that is still running when
+         * a phase begins keeps its memory until it calls this again. Each system also runs within a ScratchScope, so
+         * what it allocates is freed once its onUpdate() and forEach have finished.
+         * @returns The arena of the calling thread. It is made the first time the thread asks for one.
+         */
+        [[nodiscard]] ScratchArena &getScratch();
+        
+        /**
+         * @brief Reports the memory used by every archetype, component array and the book-keeping around them.
+         * @returns The memory used by the ecs system. Use MemoryReport::top() to find the largest archetypes.
+         */
+        [[nodiscard]] MemoryReport getMemoryReport() const;
+        
+        /**
+         * @brief Reports how many entities each archetype holds, which add/remove transitions happen the most and how
+         * many archetypes each system looks at. Transitions and queries need ECS_ENABLE_PROFILING.
+         * @returns How fragmented the archetypes are.
+         */
+        [[nodiscard]] ArchetypeReport getArchetypeReport() const;
+        
+        /**
+         * @brief Gets the hardware counters (cycles, cache misses etc.) recorded while iterating over each archetype.
+         * Only recorded on Linux when built with ECS_ENABLE_PERF_COUNTERS. Per system counters are in
+         * getSystemStatistics().
+         * @returns The counters of every archetype.
+         */
+        [[nodiscard]] std::vector<ArchetypeCounterStatistics> getArchetypeCounterStatistics() const;
+        
+        /**
+         * @brief Starts recording every call made to this Core (create, add, remove, destroy, getComponent and each
+         * phase) into a binary file that can be replayed with WorkloadReplayer. Throws if the file can't be opened.
+         * @param path - The file that you want to record to. Overwritten if it already exists.
+         */
+        void startRecording(const std::string &path);
+        
+        /**
+         * @brief Stops recording and closes the file.
+         */
+        void stopRecording();
+        
+        /**
+         * @brief Gets the number of heap allocations made by each phase the last time it ran. Only recorded when
+         * built with ECS_ENABLE_ALLOCATION_COUNTING. Per system allocations are in getSystemStatistics().
+         * @returns The allocations of each phase.
+         */
+        [[nodiscard]] PhaseAllocationStatistics getPhaseAllocations() const;
+        
+        /**
+         * @brief When enabled, each phase throws if it allocated anything. Use this to check that a steady-state frame
+         * (no new archetypes or systems) does not touch the heap. Does nothing unless built with
+         * ECS_ENABLE_ALLOCATION_COUNTING.
+         * @param enabled - Whether allocations should be treated as an error.
+         */
+        void expectNoAllocations(bool enabled);
+        
+        /**
+         * @brief Gets p50, p99, p99.9 and max of a phase over the last ECS_LATENCY_WINDOW_SIZE frames. Only recorded
+         * when built with ECS_ENABLE_PROFILING. Per system latencies are in getSystemStatistics().
+         * @param phase - The phase you want the latency of.
+         * @returns The percentiles of the phase.
+         */
+        [[nodiscard]] LatencyPercentiles getPhaseLatency(phase::phase phase) const;
+        
+        /**
+         * @brief Calls callback whenever phase takes longer than budget, right after the phase finishes. Use it to
+         * capture whatever context you need to explain the spike. Works without ECS_ENABLE_PROFILING.
+         * @param phase - The phase you want to watch.
+         * @param budget - The longest the phase should take. Zero removes the budget.
+         * @param callback - Called with the phase and how long it took.
+         */
+        void setPhaseBudget(phase::phase phase, std::chrono::nanoseconds budget, PhaseBudgetCallback callback);
+        
+        /**
+         * @brief Publishes a frame into a POSIX shared memory ring buffer after every update() so that another process
+         * can watch it (E.g.: tools/StatsMonitor). Publishing is wait-free and does not allocate. Per system timings
+         * need ECS_ENABLE_PROFILING. Throws if the shared memory object could not be created.
+         * @param name - The name of the shared memory object. E.g.: "/ecs-stats".
+         * @see SharedStats
+         */
+        void startStatsExport(const std::string &name);
+        
+        /**
+         * @brief Stops publishing and removes the shared memory object.
+         */
+        void stopStatsExport();
     
     protected:
+        using Clock = std::chrono::steady_clock;
+        
+        /**
+         * @brief What was measured at the start of a phase.
+         */
+        struct PhaseStart
+        {
+            Clock::time_point   time;
+            AllocationCounts    allocations;
+        };
+        
+        struct PhaseBudget
+        {
+            std::chrono::nanoseconds    budget      { 0 };
+            PhaseBudgetCallback         callback;
+        };
+        
+        /**
+         * @brief Starts a new scratch phase (each thread resets its own arena the next time it asks for it) and gives
+         * the calling thread's arena to the system manager.
+         * @returns The time and allocations at the start of a phase.
+         */
+        [[nodiscard]] PhaseStart beginPhase();
+        
+        /**
+         * @brief Records the time and allocations of a phase, calls its budget callback if it took too long and
+         * throws if allocations aren't expected.
+         * @param phase - The phase that just finished.
+         * @param allocations - Where to store the allocations of the phase.
+         * @param start - What beginPhase() returned.
+         */
+        void endPhase(phase::phase phase, AllocationCounts &allocations, const PhaseStart &start);
+        
+        /**
+         * @brief Writes the latest frame into the shared memory started with startStatsExport().
+         */
+        void publishStats();
+        
+        /**
+         * @brief Records a component that was just added to an entity, taken from where it ended up. Only call
+         * while recording.
+         * @tparam T - The type of the component.
+         * @param eId - The entity it was added to.
+         * @param cId - The component Id of T.
+         */
+        template<typename T>
+        void recordAdd(Entity eId, Component cId);
+        
+        /**
+         * @brief Records a remove for each of components that entity has, before they are removed. The rest are
+         * ignored by remove(), but a recorded remove of one of them would throw when replayed. Only call while
+         * recording.
+         * @param entity - The entity they are removed from.
+         * @param components - The components that were passed to remove().
+         * @param count - The number of components.
+         */
+        void recordRemove(Entity entity, const Component *components, uint64_t count);
+        
         int                 mInitSettings   { initFlag::None };
         EntityManager       mEntityManager;
+        
+        /**
+         * Every component that was created with a layout. Nodes never move, so archetypes can refer to them.
+         * Declared before the archetype manager so that it is destroyed after it.
+         */
+        std::unordered_map<Component, ComponentLayout> mLayouts;
+        
         ArchetypeManager    mArchetypeManager;
         SystemManager       mSystemManager;
+        
+        // Only set while recording.
+        std::unique_ptr<WorkloadRecorder> mRecorder;
+        
+        PhaseAllocationStatistics   mPhaseAllocations;
+        bool                        mExpectNoAllocations    { false };
+        
+        std::array<PhaseBudget, phase::Count>   mPhaseBudgets;
+        
+        /** How long each phase took the last time it ran. */
+        std::array<std::chrono::nanoseconds, phase::Count> mPhaseTimes {};
+        
+        // Only set while exporting.
+        std::unique_ptr<StatsExporter> mStatsExporter;
+        
+        /** Tells the scratch arenas that each thread has cached apart from those of other cores. */
+        const uint64_t mId;
+        
+        /** The scratch arena of a single thread. Only that thread touches arena and phase. */
+        struct ThreadScratch
+        {
+            std::thread::id thread;
+            ScratchArena    arena;
+            
+            /** The value of mScratchPhase when arena was last reset. */
+            uint64_t        phase   { 0 };
+        };
+        
+        /** Bumped by beginPhase(). Each thread resets its own arena once it sees a new value. */
+        std::atomic<uint64_t> mScratchPhase { 0 };
+        
+        /** One for every thread that has asked for one. They never move, so threads can cache them. */
+        mutable std::mutex mScratchMutex;
+        std::vector<std::unique_ptr<ThreadScratch>> mScratchArenas;
+#ifdef ECS_ENABLE_PROFILING
+        std::array<LatencyHistogram, phase::Count> mPhaseLatencies;
+#endif
     };
 }
 
+// Entities needs a complete Core, while the implementation below needs a complete IEntities.
+#include "Entities.h"
+
 
 namespace ecs
 {
     // Deliberately separating with a namespace to show that this is the implementation.
     template<typename T>
-    Component Core::create(const creationType flag)
+    ComponentId<T> Core::create(const creationType flag)
     {
-        Component out = mEntityManager.createComponent<T>();
+        const Component out = mEntityManager.createComponent<T>();
         if (flag == creationType::TypeDefault)
             mEntityManager.makeFoundationComponent(out);
-        return out;
+        if (mRecorder)
+            mRecorder->recordCreateComponent(out, sizeof(T), flag == creationType::TypeDefault);
+        return { out };
     }
     
     template<typename T, typename... Args>
@@ -216,7 +712,7 @@ namespace ecs
         
         IEntities * const entities       = system->getEntities();
         entities->mEcsRegisteredTo = this;
-        const std::vector<uint64_t> typeHashes = entities->getUnderlyingTypeHashes();
+        const std::vector<TypeIndex> types = entities->getUnderlyingTypes();
         
         if (mInitSettings & initFlag::AutoInitialise)
         {
@@ -225,13 +721,13 @@ namespace ecs
             for (int i = 0; i < uType.size(); ++i)
                 components[i] = uType[i];  // Switch out the ones that the user has already defined.
             
-            verifySystem(components, typeHashes);
+            verifySystem(components, types);
             
             mSystemManager.addSystem(components, std::move(system));
             return;
         }
         
-        verifySystem(uType, typeHashes);
+        verifySystem(uType, types);
         
         mSystemManager.addSystem(uType, std::move(system));
     }
@@ -244,54 +740,189 @@ namespace ecs
         
         std::unique_ptr<T> system = std::make_unique<T>(std::forward<Args>(args)...);
         
-        IEntities * const     entities    = system->getEntities();
+        IEntities * const entities = system->getEntities();
         entities->mEcsRegisteredTo = this;
-        const std::vector<uint64_t> typeHashes  = entities->getUnderlyingTypeHashes();
-        const UType                 components  = entities->getDefaultComponents();
         
-        verifySystem(components, typeHashes);  // Should never throw here, but it's a nice redundancy check.
+        // The defaults always have the right type, so there's nothing to verify.
+        mSystemManager.addSystem(entities->getDefaultComponents(), std::move(system));
+    }
+    
+    template<typename T, typename... Ts, typename... Args>
+    void Core::createSystem(TypedUType<Ts...> uType, Args &&... args)
+    {
+        static_assert(std::is_base_of<IBaseSystem, T>(),
+                      "T must be a base system E.g.: MySystem : public ecs::BaseSystem<>");
+        static_assert(std::is_same<std::tuple<Ts...>, typename T::ComponentTypes>(),
+                      "uType must have the same types, in the same order, as the system E.g.: BaseSystem<A, B> => TypedUType<A, B>");
+        
+        std::unique_ptr<T> system = std::make_unique<T>(std::forward<Args>(args)...);
+        system->getEntities()->mEcsRegisteredTo = this;
         
-        mSystemManager.addSystem(components, std::move(system));
+        mSystemManager.addSystem(std::apply([](const auto &...ids) { return UType { ids.id... }; }, uType), std::move(system));
     }
     
     template<typename T>
     void Core::add(Entity eId, Component cId, const T &value)
     {
-        mArchetypeManager.add(eId, cId, value);
+        mArchetypeManager.emplace<T>(eId, cId, value);
+        if (mRecorder)
+            recordAdd<T>(eId, cId);
+    }
+    
+    template<typename T, typename C, typename>
+    void Core::add(Entity eId, C cId, T &&value)
+    {
+        mArchetypeManager.emplace<std::remove_cv_t<T>>(eId, cId, std::forward<T>(value));
+        if (mRecorder)
+            recordAdd<std::remove_cv_t<T>>(eId, cId);
+    }
+    
+    template<typename T>
+    void Core::add(Entity eId, ComponentId<T> cId, const T &value)
+    {
+        emplace<T>(eId, cId, value);
+    }
+    
+    template<typename T>
+    void Core::add(Entity eId, ComponentId<T> cId, T &&value)
+    {
+        emplace<T>(eId, cId, std::move(value));
     }
     
     template<typename T>
-    void Core::add(Entity eId, const T &value)
+    void Core::add(Entity eId, T &&value)
+    {
+        emplace<std::decay_t<T>>(eId, std::forward<T>(value));
+    }
+    
+    template<typename A, typename B, typename ...Ts, typename>
+    void Core::add(Entity eId, A &&a, B &&b, Ts &&...values)
     {
-        const auto cId = mEntityManager.getComponentIdOf<T>();
-        mArchetypeManager.add(eId, cId, value);
+        const std::array<Component, 2 + sizeof...(Ts)> components {
+            mEntityManager.getComponentIdOf<std::decay_t<A>>(),
+            mEntityManager.getComponentIdOf<std::decay_t<B>>(),
+            mEntityManager.getComponentIdOf<std::decay_t<Ts>>()... };
+        mArchetypeManager.add(eId, components, std::forward<A>(a), std::forward<B>(b), std::forward<Ts>(values)...);
+        
+        if (mRecorder)
+        {
+            uint64_t i = 2;
+            recordAdd<std::decay_t<A>>(eId, components[0]);
+            recordAdd<std::decay_t<B>>(eId, components[1]);
+            (recordAdd<std::decay_t<Ts>>(eId, components[i++]), ...);
+        }
+    }
+    
+    template<typename T, typename ...Ts>
+    void Core::remove(Entity entity)
+    {
+        const std::array<Component, 1 + sizeof...(Ts)> components {
+            mEntityManager.getComponentIdOf<T>(),
+            mEntityManager.getComponentIdOf<Ts>()... };
+        if (mRecorder)
+            recordRemove(entity, components.data(), components.size());
+        mArchetypeManager.remove(entity, components.data(), components.size());
+    }
+    
+    template<typename T, typename ...Ts>
+    void Core::reserve(uint64_t count)
+    {
+        const Type type { mEntityManager.getComponentIdOf<T>(), mEntityManager.getComponentIdOf<Ts>()... };
+        mArchetypeManager.createArchetype<T, Ts...>(mEntityManager.getComponentIdOf<T>(), mEntityManager.getComponentIdOf<Ts>()...);
+        mArchetypeManager.reserve(type, count);
+    }
+    
+    template<typename T, typename ...Args>
+    T &Core::emplace(Entity eId, Args &&...args)
+    {
+        const ComponentId<T> cId { mEntityManager.getComponentIdOf<T>() };
+        return emplace<T>(eId, cId, std::forward<Args>(args)...);
+    }
+    
+    template<typename T, typename ...Args>
+    T &Core::emplace(Entity eId, ComponentId<T> cId, Args &&...args)
+    {
+        T &component = mArchetypeManager.emplace<T>(eId, cId.id, std::forward<Args>(args)...);
+        
+        // Recorded from where it ended up, since args may not be a T (or may have been moved from).
+        if (mRecorder)
+            recordAdd<T>(eId, cId.id);
+        return component;
+    }
+    
+    template<typename T>
+    void Core::recordAdd(Entity eId, Component cId)
+    {
+        const T &component = mArchetypeManager.getComponent<T>(eId, cId);
+        mRecorder->recordAdd(eId, cId, &component, sizeof(T), std::is_trivially_copyable_v<T>);
     }
     
     template<typename... EArgs>
-    void Core::processEntities(Entities<EArgs...> &entities, const UType &uType)
+    ProcessStatistics Core::processEntities(Entities<EArgs...> &entities, const UType &uType)
+    {
+        return processEntities<EArgs...>(entities.mArchetypeCache, uType, [&entities](EArgs &...args) {
+            entities.invoke(args...);
+        });
+    }
+    
+    template<typename ...EArgs, typename Function>
+    ProcessStatistics Core::processEntities(ArchetypeCache &cache, const UType &uType, Function &&function)
     {
-        std::vector<Archetype*> archetypes = mArchetypeManager.getArchetypesWithSubset(uType);
+        mArchetypeManager.updateArchetypesWithSubset(uType, cache);
         
-        for (Archetype *archetype : archetypes)
+        ProcessStatistics statistics { 0, cache.archetypes.size() };
+        for (Archetype *archetype : cache.archetypes)
         {
             auto uTypeIt = uType.begin();
             std::tuple<ComponentArray<EArgs>*...> arrays = archetype->getArraysOfType_s<EArgs...>(uTypeIt);
             
-            for (int i = 0; i < std::get<0>(arrays)->data.size(); ++i)
-                entities.invoke(std::forward_as_tuple(std::get<ComponentArray<EArgs>*>(arrays)->data[i]...));
+#ifdef ECS_ENABLE_PERF_COUNTERS
+            const HardwareCounters countersBefore = PerfCounters::read();
+#endif
+            const uint64_t count = std::get<0>(arrays)->data.size() - archetype->getDisabledCount();
+            archetype->forEachEnabledRange(std::get<0>(arrays)->data.size(), [&](uint64_t begin, uint64_t end) {
+                for (uint64_t i = begin; i < end; ++i)
+                    function(std::get<ComponentArray<EArgs>*>(arrays)->data[i]...);
+            });
+            statistics.entityCount += count;
+#ifdef ECS_ENABLE_PERF_COUNTERS
+            archetype->recordIteration(count, PerfCounters::read() - countersBefore);
+#endif
         }
+        return statistics;
+    }
+    
+    template<typename Function>
+    ProcessStatistics Core::forEachChunk(Query &query, Function &&function)
+    {
+        mArchetypeManager.updateQuery(query);
+        
+        const uint64_t columnCount = query.mComponents.size();
+        ProcessStatistics statistics { 0, query.mArchetypes.size() };
+        for (uint64_t i = 0; i < query.mArchetypes.size(); ++i)
+        {
+            Archetype * const archetype = query.mArchetypes[i];
+            const uint64_t *columnIndices = query.mColumnIndices.data() + i * columnCount;
+            
+            // Each run of enabled rows is its own chunk, so callbacks never see a disabled entity.
+            archetype->forEachEnabledRange(archetype->count(), [&](uint64_t begin, uint64_t end) {
+                function(ColumnChunk { archetype, columnIndices, end - begin, begin });
+            });
+            statistics.entityCount += archetype->count() - archetype->getDisabledCount();
+        }
+        return statistics;
     }
     
     template<typename T>
-    Component Core::getComponentIdOf()
+    ComponentId<T> Core::getComponentIdOf()
     {
-        return mEntityManager.getComponentIdOf<T>();
+        return { mEntityManager.getComponentIdOf<T>() };
     }
     
     template<typename T>
-    Component Core::get()
+    ComponentId<T> Core::get()
     {
-        return mEntityManager.getComponentIdOf<T>();
+        return { mEntityManager.getComponentIdOf<T>() };
     }
     
     template<typename T>
@@ -299,15 +930,25 @@ namespace ecs
     {
         // Component has not been registered.
         // Type T does not match up with id component.
-        if (!mEntityManager.isValid(component, typeid(T).hash_code()))
+        if (!mEntityManager.isValid(component, typeIndexOf<T>()))
             throw std::exception();
+        if (mRecorder)
+            mRecorder->recordGetComponent(entity, component);
         return mArchetypeManager.getComponent<T>(entity, component);
     }
     
+    template<typename T>
+    T &Core::getComponent(Entity entity, ComponentId<T> component)
+    {
+        if (mRecorder)
+            mRecorder->recordGetComponent(entity, component.id);
+        return mArchetypeManager.getComponent<T>(entity, component.id);
+    }
+    
     template<typename T>
     T &Core::getComponent(Entity entity)
     {
-        return getComponent<T>(entity, get<T>());
+        return getComponent(entity, get<T>());  // The default is always a T, so there's nothing to validate.
     }
     
     template<typename T>
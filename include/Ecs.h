@@ -9,6 +9,10 @@
 #pragma once
 
 #include "Common.h"
+#include "ComponentLayout.h"
 #include "BaseSystem.h"
 #include "Entities.h"
-#include "Core.h"
\ No newline at end of file
+#include "Core.h"
+#include "Query.h"
+#include "Pipeline.h"
+#include "StaticWorld.h"
@@ -0,0 +1,139 @@
+/**
+ * @file EcsC.h A C interface over ecs::Core for language bindings (E.g.: Lua, C# or Python).
+ * Every call works on a batch of entities so that the cost of crossing the language boundary is spread over many
+ * rows. Components added through this interface are created from a layout (see ecs::ComponentLayout). Queries can
+ * include any component, including ones created in C++.
+ * Functions that can fail return ECS_OK (0) on success. C++ exceptions never leave these functions.
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct EcsCore  EcsCore;
+typedef struct EcsQuery EcsQuery;
+
+typedef uint64_t EcsEntity;
+typedef uint64_t EcsComponent;
+
+typedef enum EcsResult
+{
+    ECS_OK      = 0,
+    ECS_ERROR   = 1     /* Something threw within the ecs system. E.g.: an invalid entity or component. */
+} EcsResult;
+
+/** The same as ecs::FieldLayout. */
+typedef struct EcsFieldLayout
+{
+    const char  *name;
+    uint64_t    offset;
+    uint64_t    size;
+} EcsFieldLayout;
+
+/** The same as ecs::ComponentLayout. name and fields are copied. */
+typedef struct EcsComponentLayout
+{
+    const char              *name;          /* Can be NULL. */
+    uint64_t                size;
+    uint64_t                alignment;      /* Must be a power of two. */
+    const EcsFieldLayout    *fields;        /* Can be NULL if fieldCount is 0. */
+    uint64_t                fieldCount;
+    void                    (*construct)(void *component);     /* Can be NULL. */
+    void                    (*destruct)(void *component);      /* Can be NULL. */
+} EcsComponentLayout;
+
+/**
+ * @brief Called once for each run of enabled entities within each archetype that matches a query.
+ * @param userData - Whatever was passed into ecsQueryForEach().
+ * @param count - The number of entities in the run.
+ * @param columns - The first element of each queried component, in the order that they were queried.
+ * @param strides - The number of bytes between each element of each column.
+ */
+typedef void (*EcsChunkCallback)(void *userData, uint64_t count, void *const *columns, const uint64_t *strides);
+
+/**
+ * @param flags - The same as ecs::initFlag.
+ * @returns A new core, or NULL if it could not be created. Free it with ecsDestroyCore().
+ */
+EcsCore *ecsCreateCore(int flags);
+
+void ecsDestroyCore(EcsCore *core);
+
+/**
+ * @brief Creates a component from a layout.
+ * @param out - Where the id of the new component is written.
+ */
+EcsResult ecsCreateComponent(EcsCore *core, const EcsComponentLayout *layout, EcsComponent *out);
+
+/**
+ * @brief Creates count entities that each have every one of components. They go straight into their archetype.
+ * @param components - componentCount components created with ecsCreateComponent().
+ * @param values - For each component, count values packed layout size bytes apart. Either can be NULL to construct
+ * (or zero) them.
+ * @param out - Where the new entities are written. Must have room for count entities.
+ */
+EcsResult ecsSpawn(EcsCore *core, uint64_t count, const EcsComponent *components, uint64_t componentCount,
+                   const void *const *values, EcsEntity *out);
+
+/**
+ * @brief Adds component to each of entities. Nothing changes if it fails: when an entity is not alive, already has
+ * component or is given twice.
+ * @param values - count values packed layout size bytes apart. Can be NULL to construct (or zero) them.
+ */
+EcsResult ecsAdd(EcsCore *core, const EcsEntity *entities, uint64_t count, EcsComponent component, const void *values);
+
+/**
+ * @brief Removes component from each of entities. Nothing changes if it fails: when an entity does not have component
+ * or is given twice.
+ */
+EcsResult ecsRemove(EcsCore *core, const EcsEntity *entities, uint64_t count, EcsComponent component);
+
+/**
+ * @brief Destroys each of entities and all of their components. Nothing changes if it fails: when an entity is not
+ * alive or is given twice.
+ */
+EcsResult ecsDestroy(EcsCore *core, const EcsEntity *entities, uint64_t count);
+
+/**
+ * @brief Stops (or resumes) each of entities from being passed into queries. None of their components are moved.
+ * Nothing changes if it fails: when an entity does not have any components.
+ * @param enabled - Zero to disable them, anything else to enable them.
+ */
+EcsResult ecsSetEnabled(EcsCore *core, const EcsEntity *entities, uint64_t count, int enabled);
+
+/**
+ * @returns The address of an entity's component, or NULL if it does not have it. Only valid until the next change.
+ */
+void *ecsGetComponent(EcsCore *core, EcsEntity entity, EcsComponent component);
+
+/**
+ * @brief Creates a query. Keep it and reuse it, since it remembers every archetype that it has matched.
+ * @param components - Archetypes must have all of these. Columns are given for each, in this order.
+ * @param with - Archetypes must also have all of these, but no columns are given. Can be NULL if withCount is 0.
+ * @param without - Archetypes must have none of these. Can be NULL if withoutCount is 0.
+ * @returns A new query, or NULL if it could not be created. Free it with ecsDestroyQuery().
+ */
+EcsQuery *ecsCreateQuery(EcsCore *core, const EcsComponent *components, uint64_t componentCount,
+                         const EcsComponent *with, uint64_t withCount,
+                         const EcsComponent *without, uint64_t withoutCount);
+
+void ecsDestroyQuery(EcsQuery *query);
+
+/**
+ * @brief Calls callback for each archetype that matches query and has at least one enabled entity. Disabled
+ * entities split an archetype into several calls.
+ * Do not add, remove or destroy anything from within callback.
+ * @returns The number of entities that were passed into callback.
+ */
+uint64_t ecsQueryForEach(EcsCore *core, EcsQuery *query, EcsChunkCallback callback, void *userData);
+
+#ifdef __cplusplus
+}
+#endif
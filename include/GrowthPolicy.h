@@ -0,0 +1,58 @@
+/**
+ * @file GrowthPolicy.h Decides how much the component arrays of an archetype grow by when they run out of room.
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+namespace ecs
+{
+    /**
+     * @brief How much an archetype's component arrays grow by when they are full. The default behaves like std::vector.
+     * E.g.: { 1.0, 4096 } grows in fixed steps of 4096 rows. { 1.5, 0, 65536 } grows by half but never leaves
+     * more than 65536 rows unused. { 1.0, 16384, 0, 1 << 24 } never copies rows while there are less than 16M.
+     */
+    struct GrowthPolicy
+    {
+        /** The capacity is multiplied by this. Use 1 to only grow by increment. */
+        double      factor      { 2.0 };
+        
+        /** Added to the capacity after it has been multiplied by factor. */
+        uint64_t    increment   { 0 };
+        
+        /** The most rows that can be left unused after growing. 0 for no limit. */
+        uint64_t    maxSlack    { 0 };
+        
+        /**
+         * When not 0, each component array reserves address space for this many rows and commits pages as it grows.
+         * The rows then never move, so growing only costs the new pages rather than copying every row. Arrays fall
+         * back to the heap when they outgrow it or address space can't be reserved (non-POSIX platforms).
+         */
+        uint64_t    reservedRows { 0 };
+        
+        /**
+         * Asks for 2 MiB pages for memory allocated from then on, which cuts TLB misses when iterating over very large
+         * arrays. Only arrays of at least 2 MiB (or with reservedRows) use them. Check MemoryReport to see whether
+         * the OS actually gave any.
+         */
+        bool        hugePages   { false };
+        
+        /**
+         * @param capacity - The number of rows that can be stored right now.
+         * @param required - The number of rows that need to fit.
+         * @returns The capacity to grow to. Always at least required.
+         */
+        [[nodiscard]] uint64_t grow(uint64_t capacity, uint64_t required) const
+        {
+            uint64_t next = static_cast<uint64_t>(static_cast<double>(capacity) * factor) + increment;
+            if (maxSlack != 0)
+                next = std::min(next, required + maxSlack);
+            return std::max(next, required);
+        }
+    };
+}
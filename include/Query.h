@@ -0,0 +1,57 @@
+/**
+ * @file Query.h
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#pragma once
+
+#include "Common.h"
+
+#include <vector>
+
+namespace ecs
+{
+    /**
+     * @brief A set of components that is only known at runtime (E.g.: from a script or a debugging tool). Create one
+     * with Core::createQuery() and iterate over it with Core::forEachChunk().
+     * The components are compiled into bitmasks once. Archetypes are then matched against the masks as they are
+     * created and remembered, along with where each column is, so iterating does not look anything up.
+     * @author Ryan Purse
+     * @date 17/10/2026
+     */
+    class Query
+    {
+        friend class Core;
+        friend class ArchetypeManager;
+    public:
+        /**
+         * @returns The components that columns are given for, in the order that they are given.
+         */
+        [[nodiscard]] const UType &getComponents() const { return mComponents; }
+
+        /**
+         * @returns The number of archetypes that have matched so far (including empty ones).
+         */
+        [[nodiscard]] uint64_t getArchetypeCount() const { return mArchetypes.size(); }
+
+    protected:
+        /** Columns are given for these, in this order. Archetypes must have all of them. */
+        UType mComponents;
+
+        /** Archetypes must have all of these bits (from mComponents and the with filter). One bit per component. */
+        std::vector<uint64_t> mRequired;
+
+        /** Archetypes must have none of these bits (from the without filter). */
+        std::vector<uint64_t> mExcluded;
+
+        /** The number of archetypes (in creation order) that have already been checked. */
+        uint64_t mCheckedCount { 0 };
+
+        std::vector<Archetype*> mArchetypes;
+
+        /** The column index of each of mComponents within each of mArchetypes. mComponents.size() per archetype. */
+        std::vector<uint64_t> mColumnIndices;
+    };
+}
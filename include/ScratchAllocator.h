@@ -0,0 +1,146 @@
+/**
+ * @file ScratchAllocator.h Frame-scoped memory for temporary containers within systems (sorting, candidate lists,
+ * etc.), so that they don't allocate from the heap every frame.
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace ecs
+{
+    /**
+     * @brief A bump allocator. Allocating moves a pointer forward and nothing is freed until it is rewound or reset.
+     * Blocks are kept when it is reset, so once it has grown to fit a frame it never touches the heap again.
+     * Not thread safe: every thread gets its own from Core::getScratch().
+     * @author Ryan Purse
+     * @date 17/10/2026
+     */
+    class ScratchArena
+    {
+    public:
+        /** A position within the arena that it can be rewound to. */
+        struct Marker
+        {
+            uint64_t block  { 0 };
+            uint64_t offset { 0 };
+        };
+        
+        /**
+         * @param blockSize - The size of the first block. Every new block is at least twice as big as the last.
+         */
+        explicit ScratchArena(uint64_t blockSize=64 * 1024);
+        
+        ScratchArena(const ScratchArena &) = delete;
+        ScratchArena &operator=(const ScratchArena &) = delete;
+        
+        /**
+         * @brief Allocates memory that stays valid until the arena is rewound past it or reset.
+         * @param bytes - The number of bytes.
+         * @param alignment - Must be a power of two.
+         * @returns The start of the memory.
+         */
+        [[nodiscard]] void *allocate(uint64_t bytes, uint64_t alignment=alignof(std::max_align_t));
+        
+        /**
+         * @returns Where the arena is right now. Pass it to rewind() to free everything allocated after this.
+         */
+        [[nodiscard]] Marker mark() const { return { mBlock, mOffset }; }
+        
+        /**
+         * @brief Frees everything that was allocated since marker was made. Nothing is destructed.
+         * @param marker - What mark() returned.
+         */
+        void rewind(const Marker &marker);
+        
+        /**
+         * @brief Frees everything within the arena. Nothing is destructed.
+         */
+        void reset() { rewind({ }); }
+        
+        /**
+         * @returns The bytes held by every block, whether they're in use or not. Safe to call from any thread.
+         */
+        [[nodiscard]] uint64_t getReservedBytes() const { return mReservedBytes.load(std::memory_order_relaxed); }
+        
+    protected:
+        struct Block
+        {
+            std::unique_ptr<std::byte[]>    data;
+            uint64_t                        size    { 0 };
+        };
+        
+        std::vector<Block>  mBlocks;
+        uint64_t            mBlock      { 0 };
+        uint64_t            mOffset     { 0 };
+        uint64_t            mBlockSize  { 0 };
+        
+        /** The sum of the size of every block. Kept separately so that reports can read it while the arena is used. */
+        std::atomic<uint64_t> mReservedBytes { 0 };
+    };
+    
+    /**
+     * @brief Rewinds an arena when it goes out of scope, freeing everything that was allocated during it.
+     */
+    class ScratchScope
+    {
+    public:
+        explicit ScratchScope(ScratchArena &arena) : mArena(arena), mMarker(arena.mark()) { }
+        
+        ~ScratchScope() { mArena.rewind(mMarker); }
+        
+        ScratchScope(const ScratchScope &) = delete;
+        ScratchScope &operator=(const ScratchScope &) = delete;
+        
+    protected:
+        ScratchArena        &mArena;
+        ScratchArena::Marker mMarker;
+    };
+    
+    /**
+     * @brief Lets std containers allocate from a ScratchArena. Deallocating does nothing, the memory is reclaimed
+     * when the arena is rewound. E.g.: ScratchVector<Entity> candidates(core.getScratch());
+     * @tparam T - The type being allocated.
+     */
+    template<typename T>
+    class ScratchAllocator
+    {
+    public:
+        using value_type = T;
+        
+        // Implicit so that containers can be made straight from an arena.
+        ScratchAllocator(ScratchArena &arena) noexcept : mArena(&arena) { }
+        
+        template<typename U>
+        ScratchAllocator(const ScratchAllocator<U> &other) noexcept : mArena(other.getArena()) { }
+        
+        [[nodiscard]] T *allocate(std::size_t count)
+        {
+            return static_cast<T*>(mArena->allocate(count * sizeof(T), alignof(T)));
+        }
+        
+        void deallocate(T *, std::size_t) noexcept { }
+        
+        [[nodiscard]] ScratchArena *getArena() const { return mArena; }
+        
+        template<typename U>
+        bool operator==(const ScratchAllocator<U> &rhs) const { return mArena == rhs.getArena(); }
+        
+        template<typename U>
+        bool operator!=(const ScratchAllocator<U> &rhs) const { return mArena != rhs.getArena(); }
+        
+    protected:
+        ScratchArena *mArena;
+    };
+    
+    /** A vector that allocates from a ScratchArena. */
+    template<typename T>
+    using ScratchVector = std::vector<T, ScratchAllocator<T>>;
+}
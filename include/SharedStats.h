@@ -0,0 +1,87 @@
+/**
+ * @file SharedStats.h The layout of the shared memory that Core::startStatsExport() publishes to. Include this in
+ * an external monitor to read it (see tools/StatsMonitor.cpp).
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#pragma once
+
+#include "Statistics.h"
+
+#include <atomic>
+#include <cstdint>
+
+#ifndef ECS_SHARED_STATS_SLOT_COUNT
+#define ECS_SHARED_STATS_SLOT_COUNT 64
+#endif
+
+#ifndef ECS_SHARED_STATS_MAX_SYSTEMS
+#define ECS_SHARED_STATS_MAX_SYSTEMS 64
+#endif
+
+namespace ecs
+{
+    /**
+     * @brief The timings of a single system for a single frame. Only filled when built with ECS_ENABLE_PROFILING.
+     */
+    struct SharedSystemFrame
+    {
+        /** The address of the system within the exporting process. Only useful to tell systems apart. */
+        uint64_t        id              { 0 };
+        ExecutionOrder  executionOrder  { Update };
+        int64_t         onUpdateTime    { 0 };  // Nanoseconds.
+        int64_t         iterationTime   { 0 };  // Nanoseconds.
+        uint64_t        entityCount     { 0 };
+        uint64_t        archetypeCount  { 0 };
+    };
+
+    /**
+     * @brief A single frame within the ring buffer, guarded by a seqlock. sequence is odd while the frame is being
+     * written. Readers copy the frame and then check that sequence is even and has not changed.
+     */
+    struct SharedFrame
+    {
+        std::atomic<uint64_t> sequence  { 0 };
+
+        /** Starts at 1 and increases by one each time a frame is published. */
+        uint64_t frame                  { 0 };
+
+        /** The most recent time (nanoseconds) of each phase, indexed by phase::phase. */
+        int64_t  phaseTimes[phase::Count] {};
+
+        /** Entities that have at least one component. */
+        uint64_t entityCount            { 0 };
+        uint64_t archetypeCount         { 0 };
+
+        /** The bytes reserved by every component array. */
+        uint64_t componentBytes         { 0 };
+
+        uint32_t systemCount            { 0 };
+        SharedSystemFrame systems[ECS_SHARED_STATS_MAX_SYSTEMS] {};
+    };
+
+    /**
+     * @brief Everything within the shared memory. frameCount is bumped after a frame is written, so the latest
+     * frame is in slot (frameCount - 1) % slotCount.
+     */
+    struct SharedStats
+    {
+        /** Always "ECSSTATS". Check it (and version) before reading anything else. */
+        char     magic[8]               {};
+        uint32_t version                { 0 };
+        uint32_t slotCount              { 0 };
+        uint32_t maxSystems             { 0 };
+        uint32_t frameSize              { 0 };
+
+        std::atomic<uint64_t> frameCount { 0 };
+
+        SharedFrame frames[ECS_SHARED_STATS_SLOT_COUNT];
+    };
+
+    /** Increased whenever SharedStats changes. */
+    constexpr uint32_t sharedStatsVersion { 1 };
+
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "Seqlocks in shared memory need lock free atomics.");
+}
@@ -0,0 +1,390 @@
+/**
+ * @file StaticWorld.h A world whose archetypes are all known at compile time.
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#pragma once
+
+#include "Common.h"
+
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ecs
+{
+    /**
+     * @brief The components of a single archetype within a StaticWorld. The order of the components doesn't matter.
+     * @tparam Components - The types of each component. Each type can only appear once.
+     */
+    template<typename ...Components>
+    struct Signature {};
+
+    /**
+     * @brief Every archetype that a StaticWorld can store.
+     * @tparam Signatures - A Signature<...> for each archetype.
+     */
+    template<typename ...Signatures>
+    struct Archetypes {};
+
+    /**
+     * @brief A handle to an entity within a StaticWorld. Stays valid until the entity is destroyed.
+     */
+    struct StaticEntity
+    {
+        uint32_t index      { 0 };
+        uint32_t generation { 0 };
+
+        bool operator==(const StaticEntity &rhs) const { return index == rhs.index && generation == rhs.generation; }
+        bool operator!=(const StaticEntity &rhs) const { return !(*this == rhs); }
+    };
+
+    namespace staticWorld
+    {
+        /** True if T is one of Ts. */
+        template<typename T, typename ...Ts>
+        constexpr bool contains = (std::is_same_v<T, Ts> || ...);
+
+        /** True if no type appears twice. */
+        template<typename ...Ts>
+        struct unique : std::true_type {};
+
+        template<typename T, typename ...Ts>
+        struct unique<T, Ts...> : std::bool_constant<!contains<T, Ts...> && unique<Ts...>::value> {};
+
+        /** True if the signature has every one of Components. */
+        template<typename Signature, typename ...Components>
+        struct includes;
+
+        template<typename ...SignatureComponents, typename ...Components>
+        struct includes<Signature<SignatureComponents...>, Components...>
+            : std::bool_constant<(contains<Components, SignatureComponents...> && ...)> {};
+
+        /** True if the signature has exactly Components (in any order). */
+        template<typename Signature, typename ...Components>
+        struct matches;
+
+        template<typename ...SignatureComponents, typename ...Components>
+        struct matches<Signature<SignatureComponents...>, Components...>
+            : std::bool_constant<sizeof...(SignatureComponents) == sizeof...(Components)
+                                 && includes<Signature<SignatureComponents...>, Components...>::value> {};
+
+        /**
+         * @brief The storage of a single archetype. One vector per component and nothing else.
+         */
+        template<typename Signature>
+        struct Storage;
+
+        template<typename ...Components>
+        struct Storage<Signature<Components...>>
+        {
+            static_assert(unique<Components...>::value, "A component can only appear once in a Signature.");
+
+            /** True if this archetype stores T. */
+            template<typename T>
+            static constexpr bool has = contains<T, Components...>;
+
+            /** True if this archetype stores every one of Ts. */
+            template<typename ...Ts>
+            static constexpr bool hasAll = (contains<Ts, Components...> && ...);
+
+            std::tuple<std::vector<Components>...> columns;
+
+            /** The slot (StaticEntity::index) of each row. */
+            std::vector<uint32_t> slots;
+        };
+    }
+
+    template<typename ArchetypeSet>
+    class StaticWorld;
+
+    /**
+     * @brief An alternative to Core for when every archetype is known at compile time (E.g.: a dedicated server).
+     * Each archetype is a tuple of std::vectors, so there are no maps, no virtual calls and no runtime type matching.
+     * forEach() picks its archetypes at compile time and loops over raw arrays, which lets the compiler inline and
+     * vectorise the function. An entity can't change archetype; destroy it and create a new one instead.
+     * E.g.: StaticWorld<Archetypes<Signature<Position, Velocity>, Signature<Position>>> world;
+     * @tparam Signatures - A Signature<...> for each archetype.
+     * @author Ryan Purse
+     * @date 17/10/2026
+     */
+    template<typename ...Signatures>
+    class StaticWorld<Archetypes<Signatures...>>
+    {
+        static_assert(sizeof...(Signatures) > 0, "A StaticWorld needs at least one archetype.");
+
+        static constexpr uint32_t archetypeCount { sizeof...(Signatures) };
+
+        /**
+         * @returns The archetype with exactly Components, or archetypeCount if there isn't one.
+         */
+        template<typename ...Components, uint32_t ...Indices>
+        static constexpr uint32_t findArchetype(std::integer_sequence<uint32_t, Indices...>);
+
+    public:
+        /** The archetype with exactly Components. Fails to compile if there isn't one. */
+        template<typename ...Components>
+        static constexpr uint32_t archetypeOf = findArchetype<Components...>(std::make_integer_sequence<uint32_t, archetypeCount>());
+
+        /**
+         * @brief Creates an entity in the archetype that has exactly the given components.
+         * @param components - The value of each component.
+         * @returns A handle to the new entity.
+         */
+        template<typename ...Components>
+        StaticEntity create(Components &&...components);
+
+        /**
+         * @brief Destroys an entity. The last entity in its archetype is moved into its place. Throws if entity is invalid.
+         * @param entity - The entity that you want to destroy.
+         */
+        void destroy(StaticEntity entity);
+
+        /**
+         * @returns True if entity has not been destroyed.
+         */
+        [[nodiscard]] bool isValid(StaticEntity entity) const;
+
+        /**
+         * @brief Gets a component of an entity. Throws if entity is invalid or doesn't have T.
+         * WARNING: Do not store this reference, create() and destroy() move components around.
+         * @tparam T - The type of component you want.
+         * @param entity - The entity you want the component of.
+         */
+        template<typename T>
+        [[nodiscard]] T &get(StaticEntity entity);
+
+        /**
+         * @returns True if entity is valid and has a component of type T.
+         */
+        template<typename T>
+        [[nodiscard]] bool has(StaticEntity entity) const;
+
+        /**
+         * @brief Calls function with every entity that has at least Components. The archetypes are chosen at compile
+         * time and each one is a plain loop over its columns.
+         * @tparam Components - The components that function takes (by reference), in the same order.
+         * @param function - E.g.: [](Position &position, const Velocity &velocity) { ... }
+         */
+        template<typename ...Components, typename Function>
+        void forEach(Function &&function);
+
+        /**
+         * @returns The number of entities that have at least Components. Every entity if Components is empty.
+         */
+        template<typename ...Components>
+        [[nodiscard]] uint64_t count() const;
+
+        /**
+         * @brief Reserves room for count entities in the archetype that has exactly Components.
+         * @param count - The number of entities the archetype should be able to hold without reallocating.
+         */
+        template<typename ...Components>
+        void reserve(uint64_t count);
+
+    protected:
+        struct Slot
+        {
+            uint32_t archetype  { 0 };
+            uint32_t row        { 0 };
+            uint32_t generation { 0 };
+        };
+
+        /**
+         * @brief Calls function with the storage of archetype. The archetype is only known at runtime.
+         */
+        template<typename Function>
+        void visit(uint32_t archetype, Function &&function);
+
+        template<typename Function, uint32_t ...Indices>
+        void visit(uint32_t archetype, Function &&function, std::integer_sequence<uint32_t, Indices...>);
+
+        /**
+         * @returns The slot of entity. Throws if entity is not valid.
+         */
+        const Slot &slotOf(StaticEntity entity) const;
+
+        template<typename Storage, typename ...Components, typename Function>
+        static void forEachIn(Storage &storage, Function &function);
+
+        std::tuple<staticWorld::Storage<Signatures>...> mArchetypes;
+
+        std::vector<Slot>       mSlots;
+        std::vector<uint32_t>   mFreeSlots;
+    };
+
+    // Implementation
+
+    template<typename ...Signatures>
+    template<typename ...Components, uint32_t ...Indices>
+    constexpr uint32_t StaticWorld<Archetypes<Signatures...>>::findArchetype(std::integer_sequence<uint32_t, Indices...>)
+    {
+        uint32_t out = archetypeCount;
+        ((out = (out == archetypeCount && staticWorld::matches<Signatures, Components...>::value) ? Indices : out), ...);
+        return out;
+    }
+
+    template<typename ...Signatures>
+    template<typename ...Components>
+    StaticEntity StaticWorld<Archetypes<Signatures...>>::create(Components &&...components)
+    {
+        constexpr uint32_t archetype = archetypeOf<std::decay_t<Components>...>;
+        static_assert(archetype < archetypeCount, "No Signature has exactly these components.");
+
+        auto &storage = std::get<archetype>(mArchetypes);
+
+        uint32_t index;
+        if (mFreeSlots.empty())
+        {
+            index = static_cast<uint32_t>(mSlots.size());
+            mSlots.emplace_back();
+        }
+        else
+        {
+            index = mFreeSlots.back();
+            mFreeSlots.pop_back();
+        }
+
+        Slot &slot = mSlots[index];
+        slot.archetype = archetype;
+        slot.row = static_cast<uint32_t>(storage.slots.size());
+
+        (std::get<std::vector<std::decay_t<Components>>>(storage.columns).push_back(std::forward<Components>(components)), ...);
+        storage.slots.push_back(index);
+
+        return { index, slot.generation };
+    }
+
+    template<typename ...Signatures>
+    void StaticWorld<Archetypes<Signatures...>>::destroy(StaticEntity entity)
+    {
+        const Slot &slot = slotOf(entity);
+        const uint32_t row = slot.row;
+
+        visit(slot.archetype, [this, row](auto &storage) {
+            const uint32_t last = static_cast<uint32_t>(storage.slots.size() - 1);
+            if (row != last)
+            {
+                std::apply([row](auto &...columns) { ((columns[row] = std::move(columns.back())), ...); }, storage.columns);
+                storage.slots[row] = storage.slots[last];
+                mSlots[storage.slots[row]].row = row;
+            }
+            std::apply([](auto &...columns) { (columns.pop_back(), ...); }, storage.columns);
+            storage.slots.pop_back();
+        });
+
+        ++mSlots[entity.index].generation;
+        mFreeSlots.push_back(entity.index);
+    }
+
+    template<typename ...Signatures>
+    bool StaticWorld<Archetypes<Signatures...>>::isValid(StaticEntity entity) const
+    {
+        return entity.index < mSlots.size() && mSlots[entity.index].generation == entity.generation;
+    }
+
+    template<typename ...Signatures>
+    template<typename T>
+    T &StaticWorld<Archetypes<Signatures...>>::get(StaticEntity entity)
+    {
+        static_assert((staticWorld::includes<Signatures, T>::value || ...), "No Signature has T.");
+
+        const Slot &slot = slotOf(entity);
+        T *out = nullptr;
+        visit(slot.archetype, [&out, &slot](auto &storage) {
+            if constexpr (std::decay_t<decltype(storage)>::template has<T>)
+                out = &std::get<std::vector<T>>(storage.columns)[slot.row];
+        });
+
+        // The entity's archetype doesn't have T.
+        if (!out)
+            throw std::exception();
+        return *out;
+    }
+
+    template<typename ...Signatures>
+    template<typename T>
+    bool StaticWorld<Archetypes<Signatures...>>::has(StaticEntity entity) const
+    {
+        if (!isValid(entity))
+            return false;
+
+        constexpr bool archetypeHas[] = { staticWorld::includes<Signatures, T>::value... };
+        return archetypeHas[mSlots[entity.index].archetype];
+    }
+
+    template<typename ...Signatures>
+    template<typename ...Components, typename Function>
+    void StaticWorld<Archetypes<Signatures...>>::forEach(Function &&function)
+    {
+        static_assert(sizeof...(Components) > 0, "forEach() needs at least one component.");
+
+        // Archetypes without every component are removed at compile time.
+        std::apply([&function](auto &...storages) {
+            (forEachIn<std::decay_t<decltype(storages)>, Components...>(storages, function), ...);
+        }, mArchetypes);
+    }
+
+    template<typename ...Signatures>
+    template<typename Storage, typename ...Components, typename Function>
+    void StaticWorld<Archetypes<Signatures...>>::forEachIn(Storage &storage, Function &function)
+    {
+        if constexpr (Storage::template hasAll<Components...>)
+        {
+            const uint64_t count = storage.slots.size();
+            const auto columns = std::make_tuple(std::get<std::vector<Components>>(storage.columns).data()...);
+            for (uint64_t i = 0; i < count; ++i)
+                function(std::get<Components*>(columns)[i]...);
+        }
+    }
+
+    template<typename ...Signatures>
+    template<typename ...Components>
+    uint64_t StaticWorld<Archetypes<Signatures...>>::count() const
+    {
+        uint64_t out = 0;
+        std::apply([&out](const auto &...storages) {
+            ((out += std::decay_t<decltype(storages)>::template hasAll<Components...> ? storages.slots.size() : 0), ...);
+        }, mArchetypes);
+        return out;
+    }
+
+    template<typename ...Signatures>
+    template<typename ...Components>
+    void StaticWorld<Archetypes<Signatures...>>::reserve(uint64_t count)
+    {
+        constexpr uint32_t archetype = archetypeOf<Components...>;
+        static_assert(archetype < archetypeCount, "No Signature has exactly these components.");
+
+        auto &storage = std::get<archetype>(mArchetypes);
+        std::apply([count](auto &...columns) { (columns.reserve(count), ...); }, storage.columns);
+        storage.slots.reserve(count);
+    }
+
+    template<typename ...Signatures>
+    template<typename Function>
+    void StaticWorld<Archetypes<Signatures...>>::visit(uint32_t archetype, Function &&function)
+    {
+        visit(archetype, function, std::make_integer_sequence<uint32_t, archetypeCount>());
+    }
+
+    template<typename ...Signatures>
+    template<typename Function, uint32_t ...Indices>
+    void StaticWorld<Archetypes<Signatures...>>::visit(uint32_t archetype, Function &&function, std::integer_sequence<uint32_t, Indices...>)
+    {
+        ((archetype == Indices ? function(std::get<Indices>(mArchetypes)) : void()), ...);
+    }
+
+    template<typename ...Signatures>
+    const typename StaticWorld<Archetypes<Signatures...>>::Slot &StaticWorld<Archetypes<Signatures...>>::slotOf(StaticEntity entity) const
+    {
+        // The entity has been destroyed or never existed.
+        if (!isValid(entity))
+            throw std::exception();
+        return mSlots[entity.index];
+    }
+}
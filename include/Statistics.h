@@ -0,0 +1,312 @@
+/**
+ * @file Statistics.h Statistics that the ecs system can report about itself.
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#pragma once
+
+#include "Common.h"
+
+#include <chrono>
+#include <vector>
+
+namespace ecs
+{
+    class IBaseSystem;
+    
+    /**
+     * @brief Hardware performance counters read with perf_event_open. Only recorded on Linux when built with
+     * ECS_ENABLE_PERF_COUNTERS. valid is false if the counters could not be opened (E.g.: perf_event_paranoid).
+     */
+    struct HardwareCounters
+    {
+        uint64_t cycles         { 0 };
+        uint64_t instructions   { 0 };
+        uint64_t l1Misses       { 0 };
+        uint64_t llcMisses      { 0 };
+        uint64_t branchMisses   { 0 };
+        bool     valid          { false };
+        
+        HardwareCounters &operator+=(const HardwareCounters &rhs);
+        
+        /** @returns The counters that happened between rhs and this. */
+        HardwareCounters operator-(const HardwareCounters &rhs) const;
+    };
+
+    /**
+     * @brief The number of heap allocations made through operator new. Only recorded when built with
+     * ECS_ENABLE_ALLOCATION_COUNTING.
+     */
+    struct AllocationCounts
+    {
+        uint64_t allocations    { 0 };
+        uint64_t bytes          { 0 };
+        
+        AllocationCounts &operator+=(const AllocationCounts &rhs);
+        
+        /** @returns The allocations that happened between rhs and this. */
+        AllocationCounts operator-(const AllocationCounts &rhs) const;
+    };
+    
+    /** The phases that Core runs each frame. */
+    namespace phase
+    {
+        enum phase : uint8_t
+        {
+            FixedUpdate, Update, Render, ImGui,
+            
+            Count
+        };
+    }
+    
+    /**
+     * @brief Percentiles of a sliding window of timings. Only recorded when built with ECS_ENABLE_PROFILING.
+     */
+    struct LatencyPercentiles
+    {
+        std::chrono::nanoseconds p50    { 0 };
+        std::chrono::nanoseconds p99    { 0 };
+        std::chrono::nanoseconds p999   { 0 };
+        std::chrono::nanoseconds max    { 0 };
+        
+        /** The number of samples in the window. */
+        uint64_t sampleCount            { 0 };
+    };
+    
+    /**
+     * @brief The allocations made by each phase the last time it was run.
+     */
+    struct PhaseAllocationStatistics
+    {
+        AllocationCounts fixedUpdate;
+        AllocationCounts update;
+        AllocationCounts render;
+        AllocationCounts imGui;
+    };
+
+    /**
+     * @brief What happened when a system processed its entities.
+     */
+    struct ProcessStatistics
+    {
+        /** The number of entities that were passed into forEach(). */
+        uint64_t entityCount    { 0 };
+
+        /** The number of archetypes that matched the systems type. */
+        uint64_t archetypeCount { 0 };
+    };
+
+    /**
+     * @brief Everything recorded about a single system for a single frame.
+     */
+    struct SystemFrameStatistics
+    {
+        /** Time spent inside onUpdate(). */
+        std::chrono::nanoseconds onUpdateTime   { 0 };
+
+        /** Time spent iterating over the entities (forEach()). */
+        std::chrono::nanoseconds iterationTime  { 0 };
+
+        uint64_t entityCount    { 0 };
+        uint64_t archetypeCount { 0 };
+
+        /** Counted over both onUpdate() and the iteration. */
+        HardwareCounters counters;
+        
+        /** Counted over both onUpdate() and the iteration. */
+        AllocationCounts allocations;
+    };
+
+    /**
+     * @brief The hardware counters accumulated while iterating over a single archetype, across every system.
+     */
+    struct ArchetypeCounterStatistics
+    {
+        Type type;
+
+        /** The total number of rows that have been iterated over. */
+        uint64_t rowsIterated   { 0 };
+
+        HardwareCounters counters;
+    };
+
+    /**
+     * @brief The recorded history of a single system. Only filled when built with ECS_ENABLE_PROFILING.
+     */
+    struct SystemStatistics
+    {
+        /** The system that these statistics belong to. Use it to identify the system. */
+        const IBaseSystem *system { nullptr };
+
+        ExecutionOrder executionOrder { Update };
+
+        /** The last N frames with the oldest frame first. N is set with ECS_PROFILER_FRAME_COUNT. */
+        std::vector<SystemFrameStatistics> frames;
+        
+        /** The time taken by onUpdate() and the iteration over the last ECS_LATENCY_WINDOW_SIZE frames. */
+        LatencyPercentiles latency;
+    };
+    
+    /**
+     * @brief The memory used by a single component array within an archetype.
+     */
+    struct ColumnMemoryStatistics
+    {
+        Component component     { 0 };
+        uint64_t elementSize    { 0 };
+        
+        /** The bytes taken up by the components that exist. */
+        uint64_t bytesUsed      { 0 };
+        
+        /** The bytes that have been allocated (always >= bytesUsed). */
+        uint64_t bytesReserved  { 0 };
+        
+        /** How much of bytesReserved is backed by huge pages. Only non-zero with GrowthPolicy::hugePages. */
+        uint64_t bytesInHugePages { 0 };
+    };
+    
+    /**
+     * @brief The memory used by a single archetype.
+     */
+    struct ArchetypeMemoryStatistics
+    {
+        Type type;
+        uint64_t rowCount       { 0 };
+        uint64_t bytesUsed      { 0 };
+        uint64_t bytesReserved  { 0 };
+        uint64_t bytesInHugePages { 0 };
+        
+        /** The bytes used by the archetype for book-keeping (maps, array objects). Estimated. */
+        uint64_t bytesOverhead  { 0 };
+        
+        std::vector<ColumnMemoryStatistics> columns;
+    };
+    
+    /**
+     * @brief The memory used by a single component across every archetype.
+     */
+    struct ComponentMemoryStatistics
+    {
+        Component component     { 0 };
+        uint64_t rowCount       { 0 };
+        uint64_t bytesUsed      { 0 };
+        uint64_t bytesReserved  { 0 };
+        
+        /** The number of archetypes that contain this component. */
+        uint64_t archetypeCount { 0 };
+    };
+    
+    /**
+     * @brief Everything the ecs system has allocated. Anything that isn't component data is an estimate based on
+     * the number of elements in each container.
+     */
+    struct MemoryReport
+    {
+        std::vector<ArchetypeMemoryStatistics> archetypes;
+        
+        /** The entity information (type and index) stored for every entity by the archetype manager. */
+        uint64_t entityRecordBytes      { 0 };
+        
+        /** The archetype map itself, including every archetype's book-keeping. */
+        uint64_t archetypeMapBytes      { 0 };
+        
+        /** The maps within the entity manager (Ids and underlying types). */
+        uint64_t entityManagerBytes     { 0 };
+        
+        /** The blocks held by the scratch arena of every thread (Core::getScratch()). */
+        uint64_t scratchBytes           { 0 };
+        
+        /** The bytes used by all component data. */
+        uint64_t totalBytesUsed         { 0 };
+        
+        /** The bytes reserved for all component data. */
+        uint64_t totalBytesReserved     { 0 };
+        
+        /** How much of totalBytesReserved the OS actually backed with huge pages. */
+        uint64_t totalBytesInHugePages  { 0 };
+        
+        /** Everything: reserved component data and all of the overhead. */
+        uint64_t totalBytes             { 0 };
+        
+        /**
+         * @brief Gets the archetypes that have reserved the most memory.
+         * @param n - The maximum number of archetypes that you want.
+         * @returns At most n archetypes, largest first.
+         */
+        [[nodiscard]] std::vector<ArchetypeMemoryStatistics> top(uint64_t n) const;
+        
+        /**
+         * @brief Sums each component across every archetype that it's in.
+         * @returns The memory used by each component, largest first.
+         */
+        [[nodiscard]] std::vector<ComponentMemoryStatistics> byComponent() const;
+    };
+    
+    /**
+     * @brief How often an entity moved from one archetype to another by adding or removing a component.
+     */
+    struct TransitionStatistics
+    {
+        /** The type before the transition. Empty when the entity had no components. */
+        Type from;
+        Type to;
+        
+        /** The component that was added or removed. 0 when several were added or removed at once. */
+        Component component { 0 };
+        bool added          { true };
+        uint64_t count      { 0 };
+        
+        /** Every component that was added or removed. More than one for a multi-component add or remove. */
+        Type components;
+    };
+    
+    /**
+     * @brief The number of entities stored in a single archetype.
+     */
+    struct ArchetypeRowStatistics
+    {
+        Type type;
+        uint64_t rowCount   { 0 };
+    };
+    
+    /**
+     * @brief How many archetypes a system had to look at in the last frame that it ran.
+     */
+    struct SystemQueryStatistics
+    {
+        const IBaseSystem *system   { nullptr };
+        uint64_t archetypeCount     { 0 };
+        uint64_t entityCount        { 0 };
+    };
+    
+    /**
+     * @brief Describes how fragmented the archetypes are and how often entities move between them. Transitions and
+     * queries are only recorded when built with ECS_ENABLE_PROFILING.
+     */
+    struct ArchetypeReport
+    {
+        /** Every archetype that currently exists, including empty ones. */
+        std::vector<ArchetypeRowStatistics> archetypes;
+        
+        /** Every transition that has happened, the most frequent first. */
+        std::vector<TransitionStatistics> transitions;
+        
+        std::vector<SystemQueryStatistics> queries;
+        
+        uint64_t emptyArchetypeCount { 0 };
+        
+        /**
+         * @param n - The maximum number of transitions that you want.
+         * @returns The n most frequent transitions.
+         */
+        [[nodiscard]] std::vector<TransitionStatistics> hottestTransitions(uint64_t n) const;
+        
+        /**
+         * @param maxRows - The largest number of rows an archetype can have to be considered nearly empty.
+         * @returns Every archetype with maxRows or fewer rows, the emptiest first.
+         */
+        [[nodiscard]] std::vector<ArchetypeRowStatistics> nearlyEmpty(uint64_t maxRows) const;
+    };
+}
@@ -9,8 +9,8 @@
 
 #include "Common.h"
 
-#include <typeinfo>
 #include <functional>
+#include <tuple>
 
 namespace ecs
 {
@@ -35,10 +35,10 @@ namespace ecs
         virtual void onUpdate() { };
         
         /**
-         * @brief Gets the hash code of all types provided in BaseSystem<>. NOT the ids of components.
-         * @returns hash code of all types.
+         * @brief Gets the type index (typeIndexOf()) of all types provided in BaseSystem<>. NOT the ids of components.
+         * @returns type index of all types.
          */
-        [[nodiscard]] virtual std::vector<uint64_t> getUnderlyingTypeHashes() const = 0;
+        [[nodiscard]] virtual std::vector<TypeIndex> getUnderlyingTypes() const = 0;
         
         /**
          * @brief Gets the interface of the entities class so that it can be handled separately.
@@ -65,28 +65,37 @@ namespace ecs
             : public IBaseSystem
     {
     public:
+        /** The types of component that this system processes. */
+        using ComponentTypes = std::tuple<Args...>;
+        
         ~BaseSystem() override = default;
     
         /**
-         * @brief Gets the hash code of all types in ...Args. NOT the ids of components.
-         * @returns hash code of all types (...Args).
+         * @brief Gets the type index (typeIndexOf()) of all types in ...Args. NOT the ids of components.
+         * @returns type index of all types (...Args).
          */
-        [[nodiscard]] std::vector<uint64_t> getUnderlyingTypeHashes() const override;
+        [[nodiscard]] std::vector<TypeIndex> getUnderlyingTypes() const override;
         
         /**
          * @brief Gets the interface of the entities class so that it can be handled separately.
          * @returns IEntities interface class.
          */
         [[nodiscard]] IEntities *getEntities() override;
+        
+        /**
+         * @brief Gets the entities class without going through the interface. Used by Pipeline.
+         * @returns The entities class of this system.
+         */
+        [[nodiscard]] Entities<Args...> &getTypedEntities() { return mEntities; }
 
     protected:
         Entities<Args...> mEntities;
     };
     
     template<class... Args>
-    std::vector<uint64_t> BaseSystem<Args...>::getUnderlyingTypeHashes() const
+    std::vector<TypeIndex> BaseSystem<Args...>::getUnderlyingTypes() const
     {
-        return { (typeid(Args).hash_code())... };
+        return { typeIndexOf<Args>()... };
     }
     
     template<class... Args>
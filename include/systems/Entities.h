@@ -7,12 +7,15 @@
 
 #pragma once
 
-#include "Core.h"
 #include "Common.h"
+#include "BaseSystem.h"
+#include "Statistics.h"
 #include <functional>
 
 namespace ecs
 {
+    class Core;
+    
     /**
      * @brief An interface for the Entities class.
      */
@@ -23,8 +26,9 @@ namespace ecs
         /**
          * @brief Calls process entities with the correct types.
          * @param uType - The component Id that pair with each type.
+         * @returns The number of entities and archetypes that were processed.
          */
-        virtual void callbackProcessEntities(const UType &uType) = 0;
+        virtual ProcessStatistics callbackProcessEntities(const UType &uType) = 0;
     
         /**
          * @brief Gets the interface of the entities class so that it can be handled separately.
@@ -33,14 +37,17 @@ namespace ecs
         [[nodiscard]] virtual UType getDefaultComponents() const = 0;
     
         /**
-         * @brief Gets the hash code of all types provided in Entities<>. NOT the ids of components.
-         * @returns hash code of all types.
+         * @brief Gets the type index (typeIndexOf()) of all types provided in Entities<>. NOT the ids of components.
+         * @returns type index of all types.
          */
-        [[nodiscard]] virtual std::vector<uint64_t> getUnderlyingTypeHashes() const = 0;
+        [[nodiscard]] virtual std::vector<TypeIndex> getUnderlyingTypes() const = 0;
 
     protected:
         // Set when a system is created.
         Core*           mEcsRegisteredTo    { nullptr };
+        
+        // The archetypes that match this system. Kept up to date by Core::processEntities().
+        ArchetypeCache  mArchetypeCache;
     };
     
     /**
@@ -95,8 +102,9 @@ namespace ecs
         /**
          * @brief Used to obtain the correct types (Args) within this Entities.
          * @param uType - The component Id that will be paired with each Args.
+         * @returns The number of entities and archetypes that were processed.
          */
-        void callbackProcessEntities(const UType &uType) override;
+        ProcessStatistics callbackProcessEntities(const UType &uType) override;
     
         /**
          * @brief Gets the interface of the entities class so that it can be handled separately.
@@ -105,19 +113,25 @@ namespace ecs
         [[nodiscard]] UType getDefaultComponents() const override;
     
         /**
-         * @brief Gets the hash code of all types provided in Entities<>. NOT the ids of components.
-         * @returns hash code of all types.
+         * @brief Gets the type index (typeIndexOf()) of all types provided in Entities<>. NOT the ids of components.
+         * @returns type index of all types.
          */
-        [[nodiscard]] std::vector<uint64_t> getUnderlyingTypeHashes() const override;
+        [[nodiscard]] std::vector<TypeIndex> getUnderlyingTypes() const override;
 
     protected:
         FuncSignature mForEachDelegate { [](Args &... args) { } };
     };
-    
+}
+
+// Core must be complete before the implementation. Included here since Core.h also depends on IEntities.
+#include "Core.h"
+
+namespace ecs
+{
     template<class... Args>
-    void Entities<Args...>::callbackProcessEntities(const UType &uType)
+    ProcessStatistics Entities<Args...>::callbackProcessEntities(const UType &uType)
     {
-        mEcsRegisteredTo->processEntities(*this, uType);
+        return mEcsRegisteredTo->processEntities(*this, uType);
     }
     
     template<class... Args>
@@ -160,8 +174,8 @@ namespace ecs
     }
     
     template<class... Args>
-    std::vector<uint64_t> Entities<Args...>::getUnderlyingTypeHashes() const
+    std::vector<TypeIndex> Entities<Args...>::getUnderlyingTypes() const
     {
-        return { typeid(Args).hash_code()... };
+        return { typeIndexOf<Args>()... };
     }
 }
\ No newline at end of file
@@ -0,0 +1,208 @@
+/**
+ * @file Pipeline.h
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#pragma once
+
+#include "Common.h"
+#include "BaseSystem.h"
+#include "Entities.h"
+
+#include <array>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace ecs
+{
+    namespace pipeline
+    {
+        /**
+         * @brief Checks if System has a (non-virtual) onEntity(Args &...) that can be called instead of the forEach()
+         * delegate.
+         */
+        template<typename System, typename Tuple, typename = void>
+        struct hasOnEntity : std::false_type { };
+
+        template<typename System, typename ...Args>
+        struct hasOnEntity<System, std::tuple<Args...>,
+            std::void_t<decltype(std::declval<System&>().onEntity(std::declval<Args&>()...))>>
+            : std::true_type { };
+
+        /**
+         * @brief The index of T within Ts. Fails to compile if T is not in Ts.
+         */
+        template<typename T, typename ...Ts>
+        struct indexOf;
+
+        template<typename T, typename ...Ts>
+        struct indexOf<T, T, Ts...> : std::integral_constant<std::size_t, 0> { };
+
+        template<typename T, typename U, typename ...Ts>
+        struct indexOf<T, U, Ts...> : std::integral_constant<std::size_t, 1 + indexOf<T, Ts...>::value> { };
+    }
+
+    /**
+     * @brief A fixed set of systems that is known at compile time. Systems are held by value and each phase is
+     * unrolled, so onUpdate() is called without virtual dispatch and every query is bound once on construction.
+     * Systems that define onEntity(Args &...) have it called directly (and so it can be inlined), otherwise the
+     * forEach() delegate is used. Within a phase, systems run in the order that they are given.
+     * Pipelines do not record statistics and are not run by Core::update() etc. Call the phases yourself.
+     * @tparam Systems - The systems to run. Each MUST inherit from BaseSystem<> and be default constructable.
+     * @author Ryan Purse
+     * @date 17/10/2026
+     */
+    template<typename ...Systems>
+    class Pipeline
+    {
+        static constexpr std::size_t systemCount { sizeof...(Systems) };
+    public:
+        /**
+         * @brief Binds every system to core. THROWS if a component of any system has no default.
+         * @param core - The ecs system that entities are taken from. Must outlive the pipeline.
+         */
+        explicit Pipeline(Core &core);
+
+        /** @brief Runs every PreFixedUpdate and then every FixedUpdate system. */
+        void fixedUpdate();
+
+        /** @brief Runs every PreUpdate and then every Update system. */
+        void update();
+
+        /** @brief Runs every PreRender and then every Render system. */
+        void render();
+
+        /** @brief Runs every ImGui system. */
+        void imGui();
+
+        /**
+         * @tparam System - One of Systems.
+         * @returns The instance of System that this pipeline runs.
+         */
+        template<typename System>
+        [[nodiscard]] System &get();
+
+    protected:
+        template<std::size_t ...Is>
+        void bind(std::index_sequence<Is...>);
+
+        template<std::size_t I, typename ...Args>
+        void bindSystem(std::tuple<Args...> *);
+
+        template<std::size_t ...Is>
+        void runPhase(ExecutionOrder executionOrder, std::index_sequence<Is...>);
+
+        template<std::size_t I>
+        void runSystem(ExecutionOrder executionOrder);
+
+        template<std::size_t I, typename ...Args>
+        void processSystem(std::tuple<Args...> *);
+
+        Core                                    &mCore;
+        std::tuple<Systems...>                  mSystems;
+        std::array<UType, systemCount>          mUTypes;
+        std::array<ArchetypeCache, systemCount> mCaches;
+    };
+
+    template<typename ...Systems>
+    Pipeline<Systems...>::Pipeline(Core &core)
+        : mCore(core)
+    {
+        static_assert((std::is_base_of<IBaseSystem, Systems>() && ...),
+                      "Systems must be base systems E.g.: MySystem : public ecs::BaseSystem<>");
+
+        bind(std::index_sequence_for<Systems...>());
+    }
+
+    template<typename ...Systems>
+    void Pipeline<Systems...>::fixedUpdate()
+    {
+        runPhase(PreFixedUpdate, std::index_sequence_for<Systems...>());
+        runPhase(FixedUpdate, std::index_sequence_for<Systems...>());
+    }
+
+    template<typename ...Systems>
+    void Pipeline<Systems...>::update()
+    {
+        runPhase(PreUpdate, std::index_sequence_for<Systems...>());
+        runPhase(Update, std::index_sequence_for<Systems...>());
+    }
+
+    template<typename ...Systems>
+    void Pipeline<Systems...>::render()
+    {
+        runPhase(PreRender, std::index_sequence_for<Systems...>());
+        runPhase(Render, std::index_sequence_for<Systems...>());
+    }
+
+    template<typename ...Systems>
+    void Pipeline<Systems...>::imGui()
+    {
+        runPhase(ImGui, std::index_sequence_for<Systems...>());
+    }
+
+    template<typename ...Systems>
+    template<typename System>
+    System &Pipeline<Systems...>::get()
+    {
+        return std::get<pipeline::indexOf<System, Systems...>::value>(mSystems);
+    }
+
+    template<typename ...Systems>
+    template<std::size_t ...Is>
+    void Pipeline<Systems...>::bind(std::index_sequence<Is...>)
+    {
+        (bindSystem<Is>(static_cast<typename std::tuple_element_t<Is, std::tuple<Systems...>>::ComponentTypes*>(nullptr)), ...);
+    }
+
+    template<typename ...Systems>
+    template<std::size_t I, typename ...Args>
+    void Pipeline<Systems...>::bindSystem(std::tuple<Args...> *)
+    {
+        // The defaults always have the right type, so there's nothing to verify.
+        mUTypes[I] = { mCore.getComponentIdOf<Args>()... };
+    }
+
+    template<typename ...Systems>
+    template<std::size_t ...Is>
+    void Pipeline<Systems...>::runPhase(ExecutionOrder executionOrder, std::index_sequence<Is...>)
+    {
+        (runSystem<Is>(executionOrder), ...);
+    }
+
+    template<typename ...Systems>
+    template<std::size_t I>
+    void Pipeline<Systems...>::runSystem(ExecutionOrder executionOrder)
+    {
+        using System = std::tuple_element_t<I, std::tuple<Systems...>>;
+        System &system = std::get<I>(mSystems);
+
+        if (system.getExecutionOrder() != executionOrder)
+            return;
+
+        // Anything the system allocated from scratch is freed once it has finished.
+        const ScratchScope scratchScope(mCore.getScratch());
+        system.System::onUpdate();  // Qualified so that it is not a virtual call.
+        processSystem<I>(static_cast<typename System::ComponentTypes*>(nullptr));
+    }
+
+    template<typename ...Systems>
+    template<std::size_t I, typename ...Args>
+    void Pipeline<Systems...>::processSystem(std::tuple<Args...> *)
+    {
+        using System = std::tuple_element_t<I, std::tuple<Systems...>>;
+        System &system = std::get<I>(mSystems);
+
+        if constexpr (pipeline::hasOnEntity<System, std::tuple<Args...>>::value)
+            mCore.processEntities<Args...>(mCaches[I], mUTypes[I], [&system](Args &...args) {
+                system.onEntity(args...);
+            });
+        else
+            mCore.processEntities<Args...>(mCaches[I], mUTypes[I], [&entities = system.getTypedEntities()](Args &...args) {
+                entities.invoke(args...);
+            });
+    }
+}
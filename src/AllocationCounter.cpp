@@ -0,0 +1,102 @@
+/**
+ * @file AllocationCounter.cpp
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#include "AllocationCounter.h"
+
+#ifdef ECS_ENABLE_ALLOCATION_COUNTING
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    // Plain integers so that no dynamic initialisation is needed before the first allocation.
+    thread_local uint64_t allocationCount { 0 };
+    thread_local uint64_t allocationBytes { 0 };
+
+    void *allocate(std::size_t size)
+    {
+        ++allocationCount;
+        allocationBytes += size;
+        return std::malloc(size == 0 ? 1 : size);
+    }
+
+    void *allocateAligned(std::size_t size, std::align_val_t alignment)
+    {
+        ++allocationCount;
+        allocationBytes += size;
+        const auto align = static_cast<std::size_t>(alignment);
+#ifdef _WIN32
+        return _aligned_malloc(size == 0 ? 1 : size, align);
+#else
+        // aligned_alloc() requires size to be a multiple of the alignment.
+        return std::aligned_alloc(align, (size + align - 1) / align * align);
+#endif
+    }
+
+    void deallocate(void *pointer) noexcept
+    {
+        std::free(pointer);
+    }
+
+    void deallocateAligned(void *pointer) noexcept
+    {
+#ifdef _WIN32
+        _aligned_free(pointer);
+#else
+        std::free(pointer);
+#endif
+    }
+
+    void *allocateOrThrow(std::size_t size)
+    {
+        if (void *pointer = allocate(size))
+            return pointer;
+        throw std::bad_alloc();
+    }
+
+    void *allocateAlignedOrThrow(std::size_t size, std::align_val_t alignment)
+    {
+        if (void *pointer = allocateAligned(size, alignment))
+            return pointer;
+        throw std::bad_alloc();
+    }
+}
+
+void *operator new(std::size_t size) { return allocateOrThrow(size); }
+void *operator new[](std::size_t size) { return allocateOrThrow(size); }
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept { return allocate(size); }
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept { return allocate(size); }
+void *operator new(std::size_t size, std::align_val_t alignment) { return allocateAlignedOrThrow(size, alignment); }
+void *operator new[](std::size_t size, std::align_val_t alignment) { return allocateAlignedOrThrow(size, alignment); }
+void *operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept { return allocateAligned(size, alignment); }
+void *operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept { return allocateAligned(size, alignment); }
+
+void operator delete(void *pointer) noexcept { deallocate(pointer); }
+void operator delete[](void *pointer) noexcept { deallocate(pointer); }
+void operator delete(void *pointer, std::size_t) noexcept { deallocate(pointer); }
+void operator delete[](void *pointer, std::size_t) noexcept { deallocate(pointer); }
+void operator delete(void *pointer, const std::nothrow_t &) noexcept { deallocate(pointer); }
+void operator delete[](void *pointer, const std::nothrow_t &) noexcept { deallocate(pointer); }
+void operator delete(void *pointer, std::align_val_t) noexcept { deallocateAligned(pointer); }
+void operator delete[](void *pointer, std::align_val_t) noexcept { deallocateAligned(pointer); }
+void operator delete(void *pointer, std::size_t, std::align_val_t) noexcept { deallocateAligned(pointer); }
+void operator delete[](void *pointer, std::size_t, std::align_val_t) noexcept { deallocateAligned(pointer); }
+void operator delete(void *pointer, std::align_val_t, const std::nothrow_t &) noexcept { deallocateAligned(pointer); }
+void operator delete[](void *pointer, std::align_val_t, const std::nothrow_t &) noexcept { deallocateAligned(pointer); }
+#endif
+
+namespace ecs
+{
+    AllocationCounts AllocationCounter::read()
+    {
+#ifdef ECS_ENABLE_ALLOCATION_COUNTING
+        return { allocationCount, allocationBytes };
+#else
+        return {};
+#endif
+    }
+}
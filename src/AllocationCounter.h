@@ -0,0 +1,30 @@
+/**
+ * @file AllocationCounter.h
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#pragma once
+
+#include "Statistics.h"
+
+namespace ecs
+{
+    /**
+     * @brief Counts the heap allocations made by the calling thread. When built with ECS_ENABLE_ALLOCATION_COUNTING
+     * the global operator new is replaced so that every allocation in the program is counted, not just the ecs'.
+     * Always returns zero otherwise.
+     * @author Ryan Purse
+     * @date 17/10/2026
+     */
+    class AllocationCounter
+    {
+    public:
+        /**
+         * @brief Reads the running total of allocations. Subtract two reads to get what happened between them.
+         * @returns The allocations of the calling thread.
+         */
+        [[nodiscard]] static AllocationCounts read();
+    };
+}
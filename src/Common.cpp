@@ -7,11 +7,23 @@
 
 #include "Common.h"
 
+#include <atomic>
 #include <iostream>
 #include <iomanip>
 
 namespace ecs
 {
+    namespace
+    {
+        // Constant initialised, so it's safe to use during static initialisation.
+        std::atomic<TypeIndex> typeIndexCounter { 0 };
+    }
+    
+    TypeIndex nextTypeIndex()
+    {
+        return typeIndexCounter.fetch_add(1, std::memory_order_relaxed);
+    }
+    
     std::string typeToString(const Entity id)
     {
         switch (entityMask::Type & id)
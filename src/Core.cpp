@@ -6,38 +6,160 @@
 
 
 #include "Core.h"
+#include "TraceRecorder.h"
+#include "AllocationCounter.h"
+
+#include <algorithm>
+#include <atomic>
 
 namespace ecs
 {
+    namespace
+    {
+        std::atomic<uint64_t> coreCounter { 0 };
+    }
+    
+    void writeTrace(std::ostream &stream)
+    {
+        TraceRecorder::write(stream);
+    }
+    
+    void clearTrace()
+    {
+        TraceRecorder::clear();
+    }
+    
     Core::Core(int flags) :
         mInitSettings(flags),
-        mEntityManager(flags & initFlag::AutoInitialise)
+        mEntityManager(flags & initFlag::AutoInitialise),
+        mId(++coreCounter)
     {
+        mSystemManager.setScratch(&getScratch());
     }
     
     Entity Core::create()
     {
-        return mEntityManager.createEntity();
+        const Entity entity = mEntityManager.createEntity();
+        if (mRecorder)
+            mRecorder->recordCreateEntity(entity);
+        return entity;
+    }
+    
+    Component Core::create(const ComponentLayout &layout)
+    {
+        // Alignment must be a power of two.
+        if (layout.alignment == 0 || (layout.alignment & (layout.alignment - 1)) != 0)
+            throw std::exception();
+        
+        // Each layout is its own type, so it can never be mistaken for a C++ type (or another layout).
+        const Component out = mEntityManager.createComponent(nextTypeIndex());
+        mLayouts.emplace(out, layout);
+        if (mRecorder)
+            mRecorder->recordCreateComponent(out, layout.size, false);
+        return out;
+    }
+    
+    const ComponentLayout &Core::getLayout(Component component) const
+    {
+        const auto it = mLayouts.find(component);
+        if (it == mLayouts.end())
+            throw std::exception();  // The component was not created with a layout.
+        return it->second;
+    }
+    
+    void Core::addDynamic(Entity eId, Component cId, const void *value)
+    {
+        const ComponentLayout &layout = getLayout(cId);
+        if (mRecorder)
+            mRecorder->recordAdd(eId, cId, value, layout.size, value && !layout.construct && !layout.destruct);
+        mArchetypeManager.add(eId, cId, layout, value);
+    }
+    
+    void Core::spawn(uint64_t count, const UType &components, const void *const *values, Entity *out)
+    {
+        std::vector<const ComponentLayout*> layouts;
+        layouts.reserve(components.size());
+        for (const Component component : components)
+            layouts.push_back(&getLayout(component));
+        
+        // A component was given more than once.
+        if (Type(components.begin(), components.end()).size() != components.size())
+            throw std::exception();
+        
+        for (uint64_t i = 0; i < count; ++i)
+            out[i] = create();
+        
+        if (components.empty())
+            return;
+        
+        mArchetypeManager.spawn(out, count, components, layouts, values);
+        
+        if (!mRecorder)
+            return;
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            for (uint64_t j = 0; j < components.size(); ++j)
+            {
+                const ComponentLayout &layout = *layouts[j];
+                const auto *value = values && values[j] ? static_cast<const std::byte*>(values[j]) + i * layout.size : nullptr;
+                mRecorder->recordAdd(out[i], components[j], value, layout.size, value && !layout.construct && !layout.destruct);
+            }
+        }
+    }
+    
+    void *Core::getComponentData(Entity entity, Component component)
+    {
+        if (mRecorder)
+            mRecorder->recordGetComponent(entity, component);
+        return mArchetypeManager.getComponentData(entity, component);
+    }
+    
+    Query Core::createQuery(const UType &components, const UType &with, const UType &without)
+    {
+        Query query;
+        query.mComponents = components;
+        mArchetypeManager.compileQuery(query, with, without);
+        return query;
     }
     
     void Core::fixedUpdate()
     {
+        ECS_TRACE_SCOPE("FixedUpdate", "Phase");
+        if (mRecorder)
+            mRecorder->recordPhase(workloadOp::FixedUpdate);
+        const PhaseStart start = beginPhase();
         mSystemManager.fixedUpdate();
+        endPhase(phase::FixedUpdate, mPhaseAllocations.fixedUpdate, start);
     }
     
     void Core::update()
     {
+        ECS_TRACE_SCOPE("Update", "Phase");
+        if (mRecorder)
+            mRecorder->recordPhase(workloadOp::Update);
+        const PhaseStart start = beginPhase();
         mSystemManager.update();
+        endPhase(phase::Update, mPhaseAllocations.update, start);
     }
     
     void Core::render()
     {
+        ECS_TRACE_SCOPE("Render", "Phase");
+        if (mRecorder)
+            mRecorder->recordPhase(workloadOp::Render);
+        const PhaseStart start = beginPhase();
         mSystemManager.render();
+        endPhase(phase::Render, mPhaseAllocations.render, start);
     }
     
     void Core::imGui()
     {
+        ECS_TRACE_SCOPE("ImGui", "Phase");
+        if (mRecorder)
+            mRecorder->recordPhase(workloadOp::ImGui);
+        const PhaseStart start = beginPhase();
         mSystemManager.imGui();
+        endPhase(phase::ImGui, mPhaseAllocations.imGui, start);
     }
     
     void Core::makeFoundationComponent(Component id)
@@ -45,14 +167,14 @@ namespace ecs
         mEntityManager.makeFoundationComponent(id);
     }
     
-    void Core::verifySystem(const UType &uType, const std::vector<uint64_t> &underlyingTypeHashes)
+    void Core::verifySystem(const UType &uType, const std::vector<TypeIndex> &underlyingTypes)
     {
         // Miss-matched alignment. Make sure the length of uTypes matches the Systems type length.
-        if (underlyingTypeHashes.size() != uType.size())
+        if (underlyingTypes.size() != uType.size())
             throw std::exception();
-        for (int i = 0; i < underlyingTypeHashes.size(); ++i)
+        for (uint64_t i = 0; i < underlyingTypes.size(); ++i)
         {
-            if (!mEntityManager.isValid(uType[i], underlyingTypeHashes[i]))
+            if (!mEntityManager.isValid(uType[i], underlyingTypes[i]))
                 throw std::exception();  // The type has not been registered yet. The system will produce undefined results.
             // You could also have miss-aligned the types with the underlying types.
         }
@@ -60,11 +182,238 @@ namespace ecs
     
     void Core::remove(Entity entity, Component component)
     {
+        if (mRecorder)
+            mRecorder->recordRemove(entity, component);
         mArchetypeManager.remove(entity, component);
     }
     
+    void Core::remove(Entity entity, const UType &components)
+    {
+        if (mRecorder)
+            recordRemove(entity, components.data(), components.size());
+        mArchetypeManager.remove(entity, components.data(), components.size());
+    }
+    
+    void Core::recordRemove(Entity entity, const Component *components, uint64_t count)
+    {
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            // A component given twice is only removed once.
+            const bool repeated = std::find(components, components + i, components[i]) != components + i;
+            if (!repeated && mArchetypeManager.hasComponent(entity, components[i]))
+                mRecorder->recordRemove(entity, components[i]);
+        }
+    }
+    
+    void Core::destroy(Entity entity)
+    {
+        if (mRecorder)
+            mRecorder->recordDestroy(entity);
+        mArchetypeManager.destroy(entity);
+        mEntityManager.destroy(entity);
+    }
+    
+    void Core::reserve(const UType &signature, uint64_t count)
+    {
+        mArchetypeManager.reserve(Type(signature.begin(), signature.end()), count);
+    }
+    
+    void Core::setGrowthPolicy(const GrowthPolicy &policy)
+    {
+        mArchetypeManager.setGrowthPolicy(policy);
+    }
+    
+    void Core::setGrowthPolicy(const UType &signature, const GrowthPolicy &policy)
+    {
+        mArchetypeManager.setGrowthPolicy(Type(signature.begin(), signature.end()), policy);
+    }
+    
     bool Core::hasComponent(Entity entity, Component component)
     {
         return mArchetypeManager.hasComponent(entity, component);
     }
+    
+    bool Core::isValid(Entity entity)
+    {
+        return mEntityManager.isValid(entity);
+    }
+    
+    bool Core::hasAnyComponent(Entity entity) const
+    {
+        return mArchetypeManager.hasAnyComponent(entity);
+    }
+    
+    void Core::setEnabled(Entity entity, bool enabled)
+    {
+        if (mRecorder)
+            mRecorder->recordSetEnabled(entity, enabled);
+        mArchetypeManager.setEnabled(entity, enabled);
+    }
+    
+    bool Core::isEnabled(Entity entity) const
+    {
+        return mArchetypeManager.isEnabled(entity);
+    }
+    
+    std::vector<SystemStatistics> Core::getSystemStatistics() const
+    {
+        return mSystemManager.getStatistics();
+    }
+    
+    ScratchArena &Core::getScratch()
+    {
+        // Only the first call on each thread needs to lock.
+        thread_local uint64_t cachedCore { 0 };
+        thread_local ThreadScratch *cachedScratch { nullptr };
+        if (cachedCore != mId)
+        {
+            const std::lock_guard<std::mutex> lock(mScratchMutex);
+            const std::thread::id thread = std::this_thread::get_id();
+            const auto it = std::find_if(mScratchArenas.begin(), mScratchArenas.end(), [thread](const auto &scratch) {
+                return scratch->thread == thread;
+            });
+            
+            if (it != mScratchArenas.end())
+            {
+                cachedScratch = it->get();
+            }
+            else
+            {
+                cachedScratch = mScratchArenas.emplace_back(std::make_unique<ThreadScratch>()).get();
+                cachedScratch->thread = thread;
+            }
+            cachedCore = mId;
+        }
+        
+        // Reset by the thread that owns it, so nothing is rewound while it's being used.
+        const uint64_t phase = mScratchPhase.load(std::memory_order_acquire);
+        if (cachedScratch->phase != phase)
+        {
+            cachedScratch->arena.reset();
+            cachedScratch->phase = phase;
+        }
+        return cachedScratch->arena;
+    }
+    
+    MemoryReport Core::getMemoryReport() const
+    {
+        MemoryReport report;
+        mArchetypeManager.getMemoryStatistics(report);
+        report.entityManagerBytes = mEntityManager.getMemoryUsage();
+        {
+            const std::lock_guard<std::mutex> lock(mScratchMutex);
+            for (const std::unique_ptr<ThreadScratch> &scratch : mScratchArenas)
+                report.scratchBytes += scratch->arena.getReservedBytes();
+        }
+        report.totalBytes = report.totalBytesReserved + report.entityRecordBytes
+                            + report.archetypeMapBytes + report.entityManagerBytes + report.scratchBytes;
+        return report;
+    }
+    
+    ArchetypeReport Core::getArchetypeReport() const
+    {
+        ArchetypeReport report;
+        mArchetypeManager.getArchetypeStatistics(report);
+        
+        for (const SystemStatistics &system : mSystemManager.getStatistics())
+        {
+            if (system.frames.empty())
+                continue;
+            const SystemFrameStatistics &lastFrame = system.frames.back();
+            report.queries.push_back({ system.system, lastFrame.archetypeCount, lastFrame.entityCount });
+        }
+        
+        return report;
+    }
+    
+    std::vector<ArchetypeCounterStatistics> Core::getArchetypeCounterStatistics() const
+    {
+        return mArchetypeManager.getCounterStatistics();
+    }
+    
+    void Core::startRecording(const std::string &path)
+    {
+        mRecorder = std::make_unique<WorkloadRecorder>(path);
+    }
+    
+    void Core::stopRecording()
+    {
+        mRecorder.reset();
+    }
+    
+    PhaseAllocationStatistics Core::getPhaseAllocations() const
+    {
+        return mPhaseAllocations;
+    }
+    
+    void Core::expectNoAllocations(bool enabled)
+    {
+        mExpectNoAllocations = enabled;
+    }
+    
+    LatencyPercentiles Core::getPhaseLatency([[maybe_unused]] phase::phase phase) const
+    {
+#ifdef ECS_ENABLE_PROFILING
+        return mPhaseLatencies.at(phase).getPercentiles();
+#else
+        return {};
+#endif
+    }
+    
+    void Core::setPhaseBudget(phase::phase phase, std::chrono::nanoseconds budget, PhaseBudgetCallback callback)
+    {
+        mPhaseBudgets.at(phase) = { budget, std::move(callback) };
+    }
+    
+    Core::PhaseStart Core::beginPhase()
+    {
+        // Done before allocations are read, since the first phase on a thread makes its arena.
+        mScratchPhase.fetch_add(1, std::memory_order_release);
+        mSystemManager.setScratch(&getScratch());
+        return { Clock::now(), AllocationCounter::read() };
+    }
+    
+    void Core::endPhase(phase::phase phase, AllocationCounts &allocations, const PhaseStart &start)
+    {
+        const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start.time);
+        allocations = AllocationCounter::read() - start.allocations;
+        
+#ifdef ECS_ENABLE_PROFILING
+        mPhaseLatencies[phase].record(elapsed);
+#endif
+        
+        mPhaseTimes[phase] = elapsed;
+        if (phase == phase::Update && mStatsExporter)
+            publishStats();
+        
+        const PhaseBudget &budget = mPhaseBudgets[phase];
+        if (budget.budget.count() > 0 && elapsed > budget.budget && budget.callback)
+            budget.callback(phase, elapsed);
+        
+        // Something allocated during a phase while expectNoAllocations() is enabled.
+        if (mExpectNoAllocations && allocations.allocations > 0)
+            throw std::exception();
+    }
+    
+    void Core::startStatsExport(const std::string &name)
+    {
+        mStatsExporter = std::make_unique<StatsExporter>(name);
+    }
+    
+    void Core::stopStatsExport()
+    {
+        mStatsExporter.reset();
+    }
+    
+    void Core::publishStats()
+    {
+        SharedFrame &frame = mStatsExporter->beginFrame();
+        for (uint64_t i = 0; i < phase::Count; ++i)
+            frame.phaseTimes[i] = mPhaseTimes[i].count();
+        frame.entityCount = mArchetypeManager.getEntityCount();
+        frame.archetypeCount = mArchetypeManager.getArchetypeCount();
+        frame.componentBytes = mArchetypeManager.getReservedBytes();
+        frame.systemCount = mSystemManager.getLatestFrames(frame.systems, ECS_SHARED_STATS_MAX_SYSTEMS);
+        mStatsExporter->endFrame(frame);
+    }
 }
@@ -0,0 +1,239 @@
+/**
+ * @file EcsC.cpp
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#include "EcsC.h"
+#include "Core.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <utility>
+#include <vector>
+
+struct EcsCore
+{
+    explicit EcsCore(int flags) : core(flags) {}
+
+    ecs::Core core;
+};
+
+struct EcsQuery
+{
+    EcsQuery(ecs::Query query, uint64_t columnCount)
+        : query(std::move(query)), columns(columnCount), strides(columnCount) {}
+
+    ecs::Query query;
+
+    // Reused for every chunk so that iterating does not allocate.
+    std::vector<void*>      columns;
+    std::vector<uint64_t>   strides;
+};
+
+namespace
+{
+    /**
+     * @brief Calls function and turns any exception into ECS_ERROR, since exceptions can't cross a C boundary.
+     */
+    template<typename Function>
+    EcsResult guard(Function &&function)
+    {
+        try
+        {
+            function();
+            return ECS_OK;
+        }
+        catch (const std::exception &)
+        {
+            return ECS_ERROR;
+        }
+    }
+
+    /**
+     * @returns True if any entity is given more than once.
+     */
+    bool hasDuplicates(const EcsEntity *entities, uint64_t count)
+    {
+        std::vector<EcsEntity> sorted(entities, entities + count);
+        std::sort(sorted.begin(), sorted.end());
+        return std::adjacent_find(sorted.begin(), sorted.end()) != sorted.end();
+    }
+
+    ecs::UType toUType(const EcsComponent *components, uint64_t count)
+    {
+        return count == 0 ? ecs::UType() : ecs::UType(components, components + count);
+    }
+}
+
+EcsCore *ecsCreateCore(int flags)
+{
+    try
+    {
+        return new EcsCore(flags);
+    }
+    catch (const std::exception &)
+    {
+        return nullptr;
+    }
+}
+
+void ecsDestroyCore(EcsCore *core)
+{
+    delete core;
+}
+
+EcsResult ecsCreateComponent(EcsCore *core, const EcsComponentLayout *layout, EcsComponent *out)
+{
+    return guard([&]() {
+        ecs::ComponentLayout componentLayout;
+        componentLayout.name = layout->name ? layout->name : "";
+        componentLayout.size = layout->size;
+        componentLayout.alignment = layout->alignment;
+        componentLayout.construct = layout->construct;
+        componentLayout.destruct = layout->destruct;
+        for (uint64_t i = 0; i < layout->fieldCount; ++i)
+        {
+            const EcsFieldLayout &field = layout->fields[i];
+            componentLayout.fields.push_back({ field.name ? field.name : "", field.offset, field.size });
+        }
+
+        *out = core->core.create(componentLayout);
+    });
+}
+
+EcsResult ecsSpawn(EcsCore *core, uint64_t count, const EcsComponent *components, uint64_t componentCount,
+                   const void *const *values, EcsEntity *out)
+{
+    return guard([&]() {
+        core->core.spawn(count, toUType(components, componentCount), values, out);
+    });
+}
+
+EcsResult ecsAdd(EcsCore *core, const EcsEntity *entities, uint64_t count, EcsComponent component, const void *values)
+{
+    return guard([&]() {
+        const uint64_t size = core->core.getLayout(component).size;
+
+        // Checked up front so that nothing changes when the batch fails.
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            if (!core->core.isValid(entities[i]))
+                throw std::exception();  // The entity is not alive.
+            if (core->core.hasComponent(entities[i], component))
+                throw std::exception();  // The entity already has the component.
+        }
+        if (hasDuplicates(entities, count))
+            throw std::exception();  // The second add would fail after the first had been made.
+
+        const auto * const bytes = static_cast<const std::byte*>(values);
+        for (uint64_t i = 0; i < count; ++i)
+            core->core.addDynamic(entities[i], component, bytes ? bytes + i * size : nullptr);
+    });
+}
+
+EcsResult ecsRemove(EcsCore *core, const EcsEntity *entities, uint64_t count, EcsComponent component)
+{
+    return guard([&]() {
+        // Checked up front so that nothing changes when the batch fails.
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            if (!core->core.hasComponent(entities[i], component))
+                throw std::exception();  // The entity does not have the component.
+        }
+        if (hasDuplicates(entities, count))
+            throw std::exception();  // The second remove would fail after the first had been made.
+
+        for (uint64_t i = 0; i < count; ++i)
+            core->core.remove(entities[i], component);
+    });
+}
+
+EcsResult ecsDestroy(EcsCore *core, const EcsEntity *entities, uint64_t count)
+{
+    return guard([&]() {
+        // Checked up front so that nothing changes when the batch fails.
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            if (!core->core.isValid(entities[i]))
+                throw std::exception();  // The entity is not alive.
+        }
+        if (hasDuplicates(entities, count))
+            throw std::exception();  // The second destroy would be of an entity that is no longer alive.
+
+        for (uint64_t i = 0; i < count; ++i)
+            core->core.destroy(entities[i]);
+    });
+}
+
+EcsResult ecsSetEnabled(EcsCore *core, const EcsEntity *entities, uint64_t count, int enabled)
+{
+    return guard([&]() {
+        // Checked up front so that nothing changes when the batch fails.
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            if (!core->core.hasAnyComponent(entities[i]))
+                throw std::exception();  // The entity has no row to enable or disable.
+        }
+
+        for (uint64_t i = 0; i < count; ++i)
+            core->core.setEnabled(entities[i], enabled != 0);
+    });
+}
+
+void *ecsGetComponent(EcsCore *core, EcsEntity entity, EcsComponent component)
+{
+    try
+    {
+        if (!core->core.hasComponent(entity, component))
+            return nullptr;
+        return core->core.getComponentData(entity, component);
+    }
+    catch (const std::exception &)
+    {
+        return nullptr;
+    }
+}
+
+EcsQuery *ecsCreateQuery(EcsCore *core, const EcsComponent *components, uint64_t componentCount,
+                         const EcsComponent *with, uint64_t withCount,
+                         const EcsComponent *without, uint64_t withoutCount)
+{
+    try
+    {
+        return new EcsQuery(
+            core->core.createQuery(toUType(components, componentCount), toUType(with, withCount), toUType(without, withoutCount)),
+            componentCount);
+    }
+    catch (const std::exception &)
+    {
+        return nullptr;
+    }
+}
+
+void ecsDestroyQuery(EcsQuery *query)
+{
+    delete query;
+}
+
+uint64_t ecsQueryForEach(EcsCore *core, EcsQuery *query, EcsChunkCallback callback, void *userData)
+{
+    try
+    {
+        const ecs::ProcessStatistics statistics = core->core.forEachChunk(query->query, [&](const ecs::ColumnChunk &chunk) {
+            for (uint64_t i = 0; i < query->columns.size(); ++i)
+            {
+                query->columns[i] = chunk.column(i);
+                query->strides[i] = chunk.stride(i);
+            }
+            callback(userData, chunk.count, query->columns.data(), query->strides.data());
+        });
+        return statistics.entityCount;
+    }
+    catch (const std::exception &)
+    {
+        return 0;  // Only if a newly matched archetype could not be stored.
+    }
+}
@@ -6,40 +6,59 @@
 
 
 #include "EntityManager.h"
+#include "MemoryUsage.h"
 
 namespace ecs
 {
     void EntityManager::destroy(Entity id)
     {
-        mEntityToHash.erase(id);
+        mEntityToType.erase(id);
     }
     
     bool EntityManager::isValid(Entity id)
     {
-        return mEntityToHash.count(id);
+        return mEntityToType.count(id);
     }
     
     Entity EntityManager::createEntity()
     {
         const Entity id = mNextEntityId++ | mEntityGeneration | static_cast<Entity>(entityTypeFlag::Entity);
-        mEntityToHash.insert( { id, typeid(Entity).hash_code() } );
+        mEntityToType.insert( { id, typeIndexOf<Entity>() } );
+        return id;
+    }
+    
+    Component EntityManager::createComponent(TypeIndex type)
+    {
+        const Component id = mNextComponentId++ << mComponentIdShift | static_cast<Component>(entityTypeFlag::Component);
+        mEntityToType.insert( { id, type } );
         return id;
     }
     
     void EntityManager::makeFoundationComponent(Component id)
     {
-        mHashToComponentId.insert( { mEntityToHash.at(id), id } );
+        const TypeIndex type = mEntityToType.at(id);
+        if (type >= mDefaultComponents.size())
+            mDefaultComponents.resize(type + 1, 0);
+        if (mDefaultComponents[type] == 0)
+            mDefaultComponents[type] = id;  // The first default stays the default.
+    }
+    
+    bool EntityManager::isValid(Entity id, TypeIndex underlyingType)
+    {
+        const auto it = mEntityToType.find(id);
+        return it != mEntityToType.end() && it->second == underlyingType;
     }
     
-    bool EntityManager::isValid(Entity id, uint64_t underlyingType)
+    Component EntityManager::getComponentIdOf(TypeIndex type)
     {
-        if (!isValid(id))
-            return false;
-        return underlyingType == mEntityToHash.at(id);
+        // The type has no default.
+        if (type >= mDefaultComponents.size() || mDefaultComponents[type] == 0)
+            throw std::exception();
+        return mDefaultComponents[type];
     }
     
-    Component EntityManager::getComponentIdOf(uint64_t hash)
+    uint64_t EntityManager::getMemoryUsage() const
     {
-        return mHashToComponentId.at(hash);
+        return memoryUsage::of(mEntityToType) + memoryUsage::of(mDefaultComponents);
     }
 }
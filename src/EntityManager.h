@@ -10,7 +10,7 @@
 #include "Common.h"
 
 #include <unordered_map>
-#include <typeinfo>
+#include <vector>
 
 namespace ecs
 {
@@ -37,6 +37,13 @@ namespace ecs
          */
         template<typename T>
         Component createComponent();
+        
+        /**
+         * @brief Creates an Entity Id with the Type Component.
+         * @param type - The type index that the component is paired with.
+         * @return Component - A unique Id for an Entity.
+         */
+        Component createComponent(TypeIndex type);
     
         /**
          * @brief Makes the given Id the default id when handling components with the same type.
@@ -60,13 +67,13 @@ namespace ecs
         /**
          * @brief Checks if the given Entity can be paired with the underlying type.
          * @param id - The Id that you want to check.
-         * @param underlyingType - The hashed type that you want to compare it to.
+         * @param underlyingType - The type index (typeIndexOf()) that you want to compare it to.
          * @returns True if it is a valid Id. False otherwise.
          */
-        [[nodiscard]] bool isValid(Entity id, uint64_t underlyingType);
+        [[nodiscard]] bool isValid(Entity id, TypeIndex underlyingType);
     
         /**
-         * @brief Gets the component Id of T.
+         * @brief Gets the component Id of T. A single array look-up once T has a default.
          * @tparam T - The type you want the Id of.
          * @returns The component Id.
          * @see makeFoundationType();
@@ -75,16 +82,21 @@ namespace ecs
         [[nodiscard]] Component getComponentIdOf();
         
         /**
-         * @brief Gets the component Id of a hashed type.
-         * @param hash - The hash you want the Id of.
+         * @brief Gets the component Id of a type index. Throws if the type has no default.
+         * @param type - The type index (typeIndexOf()) you want the Id of.
          * @returns The component Id.
          * @see makeFoundationType();
          */
-        [[nodiscard]] Component getComponentIdOf(uint64_t hash);
+        [[nodiscard]] Component getComponentIdOf(TypeIndex type);
+        
+        /**
+         * @returns An estimate of the bytes used by this entity manager.
+         */
+        [[nodiscard]] uint64_t getMemoryUsage() const;
 
     protected:
-        std::unordered_map<Entity, uint64_t>    mEntityToHash;  // Everything at what they are.
-        std::unordered_map<uint64_t, Component> mHashToComponentId;  // The foundation types only.
+        std::unordered_map<Entity, TypeIndex>   mEntityToType;  // Everything at what they are.
+        std::vector<Component>                  mDefaultComponents;  // The foundation types only, indexed by TypeIndex. 0 if there isn't one.
     
         Entity mNextEntityId     { 1 };
         Entity mNextComponentId  { 1 };
@@ -99,25 +111,20 @@ namespace ecs
     template<typename T>
     Component EntityManager::createComponent()
     {
-        Component id = mNextComponentId++ << mComponentIdShift | static_cast<Component>(entityTypeFlag::Component);
-        mEntityToHash.insert( { id, typeid(T).hash_code() } );
-        return id;
+        return createComponent(typeIndexOf<T>());
     }
     
     template<typename T>
     Component EntityManager::getComponentIdOf()
     {
-        const auto key = typeid(T).hash_code();
-        
-        if (mHashToComponentId.count(key) < 1)
-        {
-            // T has no default value. Assign it before using it.
-            if (!mFirstOccurrenceIsDefault)
-                throw std::exception();
-            makeFoundationComponent(createComponent<T>());
-            return mHashToComponentId.at(key);
-        }
+        const TypeIndex type = typeIndexOf<T>();
+        if (type < mDefaultComponents.size() && mDefaultComponents[type] != 0)
+            return mDefaultComponents[type];
         
-        return mHashToComponentId.at(key);
+        // T has no default value. Assign it before using it.
+        if (!mFirstOccurrenceIsDefault)
+            throw std::exception();
+        makeFoundationComponent(createComponent<T>());
+        return mDefaultComponents[type];
     }
 }
@@ -0,0 +1,100 @@
+/**
+ * @file LatencyHistogram.cpp
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#include "LatencyHistogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ecs
+{
+    namespace
+    {
+        /**
+         * @returns The index of the highest set bit in value. value must not be zero.
+         */
+        uint64_t highestBit(uint64_t value)
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return 63 - __builtin_clzll(value);
+#else
+            uint64_t bit = 0;
+            while (value >>= 1)
+                ++bit;
+            return bit;
+#endif
+        }
+    }
+
+    void LatencyHistogram::record(std::chrono::nanoseconds time)
+    {
+        const uint64_t value = static_cast<uint64_t>(std::max<int64_t>(0, time.count()));
+        uint64_t &slot = mSamples[mSampleCount % mSamples.size()];
+
+        if (mSampleCount >= mSamples.size())
+            --mCounts[bucketOf(slot)];  // The oldest sample leaves the window.
+
+        slot = value;
+        ++mCounts[bucketOf(value)];
+        ++mSampleCount;
+    }
+
+    LatencyPercentiles LatencyHistogram::getPercentiles() const
+    {
+        const uint64_t count = std::min<uint64_t>(mSampleCount, mSamples.size());
+
+        // The exact max is cheap to find and is the value that matters most when hunting spikes.
+        uint64_t max = 0;
+        for (uint64_t i = 0; i < count; ++i)
+            max = std::max(max, mSamples[i]);
+
+        return {
+            getPercentile(0.5), getPercentile(0.99), getPercentile(0.999),
+            std::chrono::nanoseconds(max), count
+        };
+    }
+
+    std::chrono::nanoseconds LatencyHistogram::getPercentile(double percentile) const
+    {
+        const uint64_t count = std::min<uint64_t>(mSampleCount, mSamples.size());
+        if (count == 0)
+            return std::chrono::nanoseconds(0);
+
+        const auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(percentile * static_cast<double>(count))));
+
+        uint64_t seen = 0;
+        for (uint64_t bucket = 0; bucket < bucketCount; ++bucket)
+        {
+            seen += mCounts[bucket];
+            if (seen >= rank)
+                return std::chrono::nanoseconds(highestValueOf(bucket));
+        }
+        return std::chrono::nanoseconds(highestValueOf(bucketCount - 1));
+    }
+
+    uint64_t LatencyHistogram::bucketOf(uint64_t value)
+    {
+        if (value < subBucketCount)
+            return value;  // Small values are exact.
+
+        const uint64_t shift = std::min(highestBit(value), maxValueBits - 1) - subBucketBits;
+        const uint64_t subBucket = std::min(value >> shift, 2 * subBucketCount - 1) - subBucketCount;
+        return shift * subBucketCount + subBucketCount + subBucket;
+    }
+
+    uint64_t LatencyHistogram::highestValueOf(uint64_t bucket)
+    {
+        if (bucket < subBucketCount)
+            return bucket;
+
+        const uint64_t shift = bucket / subBucketCount - 1;
+        const uint64_t subBucket = bucket % subBucketCount;
+
+        // The bucket holds every value with these top bits.
+        return ((subBucketCount + subBucket + 1) << shift) - 1;
+    }
+}
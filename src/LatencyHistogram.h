@@ -0,0 +1,71 @@
+/**
+ * @file LatencyHistogram.h
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#pragma once
+
+#include "Statistics.h"
+
+#include <array>
+#include <chrono>
+
+#ifndef ECS_LATENCY_WINDOW_SIZE
+#define ECS_LATENCY_WINDOW_SIZE 1024
+#endif
+
+namespace ecs
+{
+    /**
+     * @brief An HDR-style (log-linear) histogram of the last ECS_LATENCY_WINDOW_SIZE samples.
+     * Each power of two is split into 32 buckets, so percentiles are within ~3% of the real value from 1ns up to
+     * over an hour. The oldest sample is removed from the histogram whenever a new one is recorded, so the
+     * percentiles only ever describe the sliding window. Never allocates.
+     * @author Ryan Purse
+     * @date 17/10/2026
+     */
+    class LatencyHistogram
+    {
+    public:
+        /**
+         * @brief Records a sample. Removes the oldest sample once the window is full.
+         * @param time - How long something took.
+         */
+        void record(std::chrono::nanoseconds time);
+
+        /**
+         * @returns p50, p99, p99.9 and max of the samples in the window. All zero if nothing has been recorded.
+         */
+        [[nodiscard]] LatencyPercentiles getPercentiles() const;
+
+        /**
+         * @param percentile - Between 0 and 1. E.g.: 0.99 for p99.
+         * @returns The highest value that is in the same bucket as the sample at percentile.
+         */
+        [[nodiscard]] std::chrono::nanoseconds getPercentile(double percentile) const;
+
+    protected:
+        static constexpr uint64_t subBucketBits     { 5 };
+        static constexpr uint64_t subBucketCount    { 1ull << subBucketBits };
+
+        /** Anything larger (~73 minutes) is put in the last bucket. */
+        static constexpr uint64_t maxValueBits      { 42 };
+        static constexpr uint64_t bucketCount       { subBucketCount * (maxValueBits - subBucketBits + 1) };
+
+        /**
+         * @returns The bucket that value is counted in.
+         */
+        [[nodiscard]] static uint64_t bucketOf(uint64_t value);
+
+        /**
+         * @returns The highest value that is counted in bucket.
+         */
+        [[nodiscard]] static uint64_t highestValueOf(uint64_t bucket);
+
+        std::array<uint32_t, bucketCount>               mCounts {};
+        std::array<uint64_t, ECS_LATENCY_WINDOW_SIZE>   mSamples {};
+        uint64_t                                        mSampleCount { 0 };
+    };
+}
@@ -0,0 +1,60 @@
+/**
+ * @file MemoryUsage.h Estimates of how much memory standard containers use.
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+namespace ecs::memoryUsage
+{
+    /** Each node in a std::map or std::set has three pointers and a colour on top of the value. */
+    constexpr uint64_t treeNodeOverhead = 4 * sizeof(void*);
+    
+    /** Each node in an std::unordered_map has a next pointer and a cached hash on top of the value. */
+    constexpr uint64_t hashNodeOverhead = 2 * sizeof(void*);
+    
+    /**
+     * @returns The bytes allocated by vector (not including what the elements own).
+     */
+    template<typename T, typename Allocator>
+    uint64_t of(const std::vector<T, Allocator> &vector)
+    {
+        return vector.capacity() * sizeof(T);
+    }
+    
+    /**
+     * @returns The estimated bytes allocated by set (not including what the elements own).
+     */
+    template<typename T>
+    uint64_t of(const std::set<T> &set)
+    {
+        return set.size() * (sizeof(T) + treeNodeOverhead);
+    }
+    
+    /**
+     * @returns The estimated bytes allocated by map (not including what the keys or values own).
+     */
+    template<typename Key, typename Value>
+    uint64_t of(const std::map<Key, Value> &map)
+    {
+        return map.size() * (sizeof(typename std::map<Key, Value>::value_type) + treeNodeOverhead);
+    }
+    
+    /**
+     * @returns The estimated bytes allocated by map (not including what the keys or values own).
+     */
+    template<typename Key, typename Value>
+    uint64_t of(const std::unordered_map<Key, Value> &map)
+    {
+        return map.size() * (sizeof(typename std::unordered_map<Key, Value>::value_type) + hashNodeOverhead)
+               + map.bucket_count() * sizeof(void*);
+    }
+}
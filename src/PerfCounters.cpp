@@ -0,0 +1,118 @@
+/**
+ * @file PerfCounters.cpp
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#include "PerfCounters.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <array>
+#include <cstring>
+#endif
+
+namespace ecs
+{
+#ifdef __linux__
+    namespace
+    {
+        /**
+         * @brief A group of counters that are all read at once. Counters that the cpu doesn't support are skipped.
+         */
+        class CounterGroup
+        {
+        public:
+            CounterGroup()
+            {
+                open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, &HardwareCounters::cycles);
+                open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, &HardwareCounters::instructions);
+                open(PERF_TYPE_HW_CACHE,
+                     PERF_COUNT_HW_CACHE_L1D
+                     | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                     | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+                     &HardwareCounters::l1Misses);
+                open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, &HardwareCounters::llcMisses);
+                open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES, &HardwareCounters::branchMisses);
+                
+                if (mLeader != -1)
+                    ioctl(mLeader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+            }
+            
+            ~CounterGroup()
+            {
+                for (uint64_t i = 0; i < mCount; ++i)
+                    close(mDescriptors[i]);
+            }
+            
+            CounterGroup(const CounterGroup &) = delete;
+            CounterGroup &operator=(const CounterGroup &) = delete;
+            
+            [[nodiscard]] HardwareCounters read() const
+            {
+                HardwareCounters counters;
+                if (mLeader == -1)
+                    return counters;
+                
+                // PERF_FORMAT_GROUP: The number of counters followed by each value.
+                std::array<uint64_t, 1 + maxCounters> buffer {};
+                if (::read(mLeader, buffer.data(), sizeof(buffer)) < static_cast<ssize_t>(sizeof(uint64_t) * (1 + mCount)))
+                    return counters;
+                
+                for (uint64_t i = 0; i < mCount; ++i)
+                    counters.*mFields[i] = buffer[1 + i];
+                counters.valid = true;
+                return counters;
+            }
+            
+        protected:
+            void open(uint32_t type, uint64_t config, uint64_t HardwareCounters::*field)
+            {
+                perf_event_attr attributes;
+                std::memset(&attributes, 0, sizeof(attributes));
+                attributes.size = sizeof(attributes);
+                attributes.type = type;
+                attributes.config = config;
+                attributes.disabled = mLeader == -1 ? 1 : 0;  // The leader enables the whole group at once.
+                attributes.exclude_kernel = 1;
+                attributes.exclude_hv = 1;
+                attributes.read_format = PERF_FORMAT_GROUP;
+                
+                // This thread, on any cpu.
+                const auto descriptor = static_cast<int>(syscall(__NR_perf_event_open, &attributes, 0, -1, mLeader, 0));
+                if (descriptor == -1)
+                    return;  // Not supported or not permitted (see /proc/sys/kernel/perf_event_paranoid).
+                
+                if (mLeader == -1)
+                    mLeader = descriptor;
+                mDescriptors[mCount] = descriptor;
+                mFields[mCount] = field;
+                ++mCount;
+            }
+            
+            static constexpr uint64_t maxCounters { 5 };
+            
+            int mLeader { -1 };
+            uint64_t mCount { 0 };
+            std::array<int, maxCounters> mDescriptors {};
+            std::array<uint64_t HardwareCounters::*, maxCounters> mFields {};
+        };
+    }
+    
+    HardwareCounters PerfCounters::read()
+    {
+        thread_local const CounterGroup counterGroup;
+        return counterGroup.read();
+    }
+#else
+    HardwareCounters PerfCounters::read()
+    {
+        return { };
+    }
+#endif
+}
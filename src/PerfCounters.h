@@ -0,0 +1,30 @@
+/**
+ * @file PerfCounters.h
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#pragma once
+
+#include "Statistics.h"
+
+namespace ecs
+{
+    /**
+     * @brief Reads the hardware performance counters of the calling thread using Linux's perf_event_open.
+     * Counters are opened the first time a thread reads them and stay open until the thread exits.
+     * Always returns invalid counters on other platforms or when perf events are not permitted.
+     * @author Ryan Purse
+     * @date 17/10/2026
+     */
+    class PerfCounters
+    {
+    public:
+        /**
+         * @brief Reads the running total of every counter. Subtract two reads to get what happened between them.
+         * @returns The counters of the calling thread.
+         */
+        [[nodiscard]] static HardwareCounters read();
+    };
+}
@@ -0,0 +1,52 @@
+/**
+ * @file ScratchAllocator.cpp
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#include "ScratchAllocator.h"
+
+#include <algorithm>
+
+namespace ecs
+{
+    ScratchArena::ScratchArena(uint64_t blockSize)
+        : mBlockSize(std::max<uint64_t>(1, blockSize))
+    {
+    
+    }
+    
+    void *ScratchArena::allocate(uint64_t bytes, uint64_t alignment)
+    {
+        while (true)
+        {
+            if (mBlock == mBlocks.size())
+            {
+                // Big enough for this allocation however it's aligned.
+                const uint64_t size = std::max(bytes + alignment, mBlocks.empty() ? mBlockSize : mBlocks.back().size * 2);
+                mBlocks.push_back({ std::make_unique<std::byte[]>(size), size });
+                mReservedBytes.fetch_add(size, std::memory_order_relaxed);
+            }
+            
+            Block &block = mBlocks[mBlock];
+            const auto base = reinterpret_cast<uintptr_t>(block.data.get());
+            const uint64_t offset = ((base + mOffset + alignment - 1) & ~(alignment - 1)) - base;
+            if (offset + bytes <= block.size)
+            {
+                mOffset = offset + bytes;
+                return block.data.get() + offset;
+            }
+            
+            // Whatever is left in this block is wasted until the arena is rewound.
+            ++mBlock;
+            mOffset = 0;
+        }
+    }
+    
+    void ScratchArena::rewind(const Marker &marker)
+    {
+        mBlock = marker.block;
+        mOffset = marker.offset;
+    }
+}
@@ -0,0 +1,103 @@
+/**
+ * @file Statistics.cpp
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#include "Statistics.h"
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+
+namespace ecs
+{
+    HardwareCounters &HardwareCounters::operator+=(const HardwareCounters &rhs)
+    {
+        cycles += rhs.cycles;
+        instructions += rhs.instructions;
+        l1Misses += rhs.l1Misses;
+        llcMisses += rhs.llcMisses;
+        branchMisses += rhs.branchMisses;
+        valid = valid || rhs.valid;
+        return *this;
+    }
+    
+    HardwareCounters HardwareCounters::operator-(const HardwareCounters &rhs) const
+    {
+        return {
+            cycles - rhs.cycles, instructions - rhs.instructions, l1Misses - rhs.l1Misses,
+            llcMisses - rhs.llcMisses, branchMisses - rhs.branchMisses, valid && rhs.valid
+        };
+    }
+    
+    AllocationCounts &AllocationCounts::operator+=(const AllocationCounts &rhs)
+    {
+        allocations += rhs.allocations;
+        bytes += rhs.bytes;
+        return *this;
+    }
+    
+    AllocationCounts AllocationCounts::operator-(const AllocationCounts &rhs) const
+    {
+        return { allocations - rhs.allocations, bytes - rhs.bytes };
+    }
+    
+    std::vector<ArchetypeMemoryStatistics> MemoryReport::top(uint64_t n) const
+    {
+        std::vector<ArchetypeMemoryStatistics> out(archetypes);
+        std::sort(out.begin(), out.end(), [](const ArchetypeMemoryStatistics &lhs, const ArchetypeMemoryStatistics &rhs) {
+            return lhs.bytesReserved + lhs.bytesOverhead > rhs.bytesReserved + rhs.bytesOverhead;
+        });
+        if (out.size() > n)
+            out.erase(out.begin() + static_cast<int64_t>(n), out.end());
+        return out;
+    }
+    
+    std::vector<ComponentMemoryStatistics> MemoryReport::byComponent() const
+    {
+        std::map<Component, ComponentMemoryStatistics> components;
+        for (const ArchetypeMemoryStatistics &archetype : archetypes)
+        {
+            for (const ColumnMemoryStatistics &column : archetype.columns)
+            {
+                ComponentMemoryStatistics &statistics = components[column.component];
+                statistics.component = column.component;
+                statistics.rowCount += archetype.rowCount;
+                statistics.bytesUsed += column.bytesUsed;
+                statistics.bytesReserved += column.bytesReserved;
+                ++statistics.archetypeCount;
+            }
+        }
+        
+        std::vector<ComponentMemoryStatistics> out;
+        out.reserve(components.size());
+        for (const auto &[_, statistics] : components)
+            out.push_back(statistics);
+        
+        std::sort(out.begin(), out.end(), [](const ComponentMemoryStatistics &lhs, const ComponentMemoryStatistics &rhs) {
+            return lhs.bytesReserved > rhs.bytesReserved;
+        });
+        return out;
+    }
+    
+    std::vector<TransitionStatistics> ArchetypeReport::hottestTransitions(uint64_t n) const
+    {
+        // Transitions are already sorted by count.
+        const auto count = static_cast<int64_t>(std::min<uint64_t>(n, transitions.size()));
+        return { transitions.begin(), transitions.begin() + count };
+    }
+    
+    std::vector<ArchetypeRowStatistics> ArchetypeReport::nearlyEmpty(uint64_t maxRows) const
+    {
+        std::vector<ArchetypeRowStatistics> out;
+        std::copy_if(archetypes.begin(), archetypes.end(), std::back_inserter(out), [maxRows](const ArchetypeRowStatistics &archetype) {
+            return archetype.rowCount <= maxRows;
+        });
+        std::sort(out.begin(), out.end(), [](const ArchetypeRowStatistics &lhs, const ArchetypeRowStatistics &rhs) {
+            return lhs.rowCount < rhs.rowCount;
+        });
+        return out;
+    }
+}
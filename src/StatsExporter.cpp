@@ -0,0 +1,84 @@
+/**
+ * @file StatsExporter.cpp
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#include "StatsExporter.h"
+
+#include <cstring>
+#include <new>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#define ECS_HAS_SHARED_MEMORY
+#endif
+
+namespace ecs
+{
+    StatsExporter::StatsExporter(const std::string &name)
+        : mName(name)
+    {
+#ifdef ECS_HAS_SHARED_MEMORY
+        shm_unlink(mName.c_str());  // Any previous readers keep the old object until they reopen.
+        const int descriptor = shm_open(mName.c_str(), O_CREAT | O_RDWR, 0644);
+        if (descriptor == -1)
+            throw std::exception();  // Unable to create the shared memory object.
+        
+        if (ftruncate(descriptor, sizeof(SharedStats)) == -1)
+        {
+            close(descriptor);
+            shm_unlink(mName.c_str());
+            throw std::exception();  // Unable to size the shared memory object.
+        }
+        
+        void *memory = mmap(nullptr, sizeof(SharedStats), PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+        close(descriptor);
+        if (memory == MAP_FAILED)
+        {
+            shm_unlink(mName.c_str());
+            throw std::exception();  // Unable to map the shared memory object.
+        }
+        
+        // A new object is zero filled. The header is written last so readers never see a half made object.
+        mStats = new (memory) SharedStats();
+        mStats->version = sharedStatsVersion;
+        mStats->slotCount = ECS_SHARED_STATS_SLOT_COUNT;
+        mStats->maxSystems = ECS_SHARED_STATS_MAX_SYSTEMS;
+        mStats->frameSize = sizeof(SharedFrame);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(mStats->magic, "ECSSTATS", sizeof(mStats->magic));
+#else
+        throw std::exception();  // Shared memory is only supported on POSIX platforms.
+#endif
+    }
+    
+    StatsExporter::~StatsExporter()
+    {
+#ifdef ECS_HAS_SHARED_MEMORY
+        munmap(mStats, sizeof(SharedStats));
+        shm_unlink(mName.c_str());
+#endif
+    }
+    
+    SharedFrame &StatsExporter::beginFrame()
+    {
+        SharedFrame &frame = mStats->frames[mFrameCount % ECS_SHARED_STATS_SLOT_COUNT];
+        
+        // Only this thread writes, so the sequence can be bumped without a read-modify-write.
+        frame.sequence.store(frame.sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        
+        frame.frame = ++mFrameCount;
+        return frame;
+    }
+    
+    void StatsExporter::endFrame(SharedFrame &frame)
+    {
+        frame.sequence.store(frame.sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        mStats->frameCount.store(mFrameCount, std::memory_order_release);
+    }
+}
@@ -0,0 +1,57 @@
+/**
+ * @file StatsExporter.h
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#pragma once
+
+#include "SharedStats.h"
+
+#include <string>
+
+namespace ecs
+{
+    /**
+     * @brief Publishes frames into a POSIX shared memory ring buffer (see SharedStats) so that another process can
+     * watch them. Writing is wait-free: a frame is never blocked by a reader, readers retry instead.
+     * Only supported on POSIX platforms.
+     * @author Ryan Purse
+     * @date 17/10/2026
+     */
+    class StatsExporter
+    {
+    public:
+        /**
+         * @brief Creates (or replaces) the shared memory object. Throws if it could not be created.
+         * @param name - The name of the shared memory object. E.g.: "/ecs-stats".
+         */
+        explicit StatsExporter(const std::string &name);
+        
+        /**
+         * @brief Unmaps and unlinks the shared memory object.
+         */
+        ~StatsExporter();
+        
+        StatsExporter(const StatsExporter &) = delete;
+        StatsExporter &operator=(const StatsExporter &) = delete;
+        
+        /**
+         * @brief Marks the next slot as being written and returns it. Must be followed by endFrame().
+         * @returns The frame that you should fill in.
+         */
+        [[nodiscard]] SharedFrame &beginFrame();
+        
+        /**
+         * @brief Marks frame as complete so that readers can see it.
+         * @param frame - What beginFrame() returned.
+         */
+        void endFrame(SharedFrame &frame);
+        
+    protected:
+        std::string     mName;
+        SharedStats     *mStats         { nullptr };
+        uint64_t        mFrameCount     { 0 };
+    };
+}
@@ -0,0 +1,143 @@
+/**
+ * @file TraceRecorder.cpp
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#include "TraceRecorder.h"
+
+#include <mutex>
+#include <vector>
+
+namespace ecs
+{
+    namespace
+    {
+        /**
+         * @brief Every buffer that has been created. Buffers live until the end of the program so that events
+         * from threads that have exited can still be written.
+         */
+        struct TraceRegistry
+        {
+            std::mutex                                  mutex;
+            std::vector<std::unique_ptr<TraceBuffer>>   buffers;
+        };
+        
+        /** All events are relative to when the program started. */
+        const TraceRecorder::Clock::time_point traceEpoch { TraceRecorder::Clock::now() };
+        
+        TraceRegistry &registry()
+        {
+            static TraceRegistry traceRegistry;
+            return traceRegistry;
+        }
+        
+        void writeString(std::ostream &stream, const char *string)
+        {
+            stream << '"';
+            for (const char *c = string; *c != '\0'; ++c)
+            {
+                if (*c == '"' || *c == '\\')
+                    stream << '\\';
+                stream << *c;
+            }
+            stream << '"';
+        }
+    }
+    
+    TraceBuffer::TraceBuffer(uint32_t threadId)
+        : events(std::make_unique<TraceEvent[]>(ECS_TRACE_BUFFER_SIZE)), threadId(threadId)
+    {
+    }
+    
+    TraceBuffer &TraceRecorder::threadBuffer()
+    {
+        thread_local TraceBuffer *buffer = nullptr;
+        if (buffer)
+            return *buffer;
+        
+        // Only locks the first time a thread records something.
+        TraceRegistry &traceRegistry = registry();
+        std::lock_guard<std::mutex> lock(traceRegistry.mutex);
+        const auto threadId = static_cast<uint32_t>(traceRegistry.buffers.size() + 1);
+        traceRegistry.buffers.emplace_back(std::make_unique<TraceBuffer>(threadId));
+        buffer = traceRegistry.buffers.back().get();
+        return *buffer;
+    }
+    
+    void TraceRecorder::record(const char *name, const char *category, Clock::time_point start, Clock::time_point end, uint64_t id)
+    {
+        TraceBuffer &buffer = threadBuffer();
+        
+        // This thread is the only writer, so a relaxed load is enough.
+        const uint64_t index = buffer.count.load(std::memory_order_relaxed);
+        if (index >= ECS_TRACE_BUFFER_SIZE)
+        {
+            buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        
+        buffer.events[index] = {
+            name, category,
+            std::chrono::duration_cast<std::chrono::nanoseconds>(start - traceEpoch).count(),
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count(),
+            id
+        };
+        
+        // Publishes the event to write().
+        buffer.count.store(index + 1, std::memory_order_release);
+    }
+    
+    void TraceRecorder::write(std::ostream &stream)
+    {
+        TraceRegistry &traceRegistry = registry();
+        std::lock_guard<std::mutex> lock(traceRegistry.mutex);
+        
+        const auto flags = stream.flags();
+        stream.setf(std::ios::fixed);
+        const auto precision = stream.precision(3);
+        
+        stream << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+        bool first = true;
+        for (const std::unique_ptr<TraceBuffer> &buffer : traceRegistry.buffers)
+        {
+            stream << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadId
+                   << ",\"args\":{\"name\":\"Thread " << buffer->threadId << "\",\"dropped\":" << buffer->dropped.load() << "}}";
+            first = false;
+            
+            const uint64_t count = buffer->count.load(std::memory_order_acquire);
+            for (uint64_t i = 0; i < count; ++i)
+            {
+                const TraceEvent &event = buffer->events[i];
+                
+                // Chrome expects microseconds.
+                stream << ",\n{\"name\":";
+                writeString(stream, event.name);
+                stream << ",\"cat\":";
+                writeString(stream, event.category);
+                stream << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->threadId
+                       << ",\"ts\":" << static_cast<double>(event.start) / 1000.0
+                       << ",\"dur\":" << static_cast<double>(event.duration) / 1000.0;
+                if (event.id != 0)
+                    stream << ",\"args\":{\"id\":" << event.id << "}";
+                stream << "}";
+            }
+        }
+        stream << "\n]}\n";
+        
+        stream.precision(precision);
+        stream.flags(flags);
+    }
+    
+    void TraceRecorder::clear()
+    {
+        TraceRegistry &traceRegistry = registry();
+        std::lock_guard<std::mutex> lock(traceRegistry.mutex);
+        for (const std::unique_ptr<TraceBuffer> &buffer : traceRegistry.buffers)
+        {
+            buffer->count.store(0, std::memory_order_release);
+            buffer->dropped.store(0, std::memory_order_relaxed);
+        }
+    }
+}
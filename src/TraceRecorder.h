@@ -0,0 +1,129 @@
+/**
+ * @file TraceRecorder.h
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#pragma once
+
+#include "Common.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <ostream>
+
+#ifndef ECS_TRACE_BUFFER_SIZE
+#define ECS_TRACE_BUFFER_SIZE 65536
+#endif
+
+#define ECS_TRACE_CONCAT_IMPL(a, b) a##b
+#define ECS_TRACE_CONCAT(a, b) ECS_TRACE_CONCAT_IMPL(a, b)
+
+#ifdef ECS_ENABLE_TRACING
+/** Records the time between here and the end of the current scope. name and category MUST be string literals. */
+#define ECS_TRACE_SCOPE(name, category) \
+    const ::ecs::TraceScope ECS_TRACE_CONCAT(ecsTraceScope, __LINE__) { name, category }
+
+/** Identical to ECS_TRACE_SCOPE but also attaches an id that is shown in the viewer. */
+#define ECS_TRACE_SCOPE_ID(name, category, id) \
+    const ::ecs::TraceScope ECS_TRACE_CONCAT(ecsTraceScope, __LINE__) { name, category, static_cast<uint64_t>(id) }
+#else
+#define ECS_TRACE_SCOPE(name, category)
+#define ECS_TRACE_SCOPE_ID(name, category, id)
+#endif
+
+namespace ecs
+{
+    /**
+     * @brief A single complete event. Times are in nanoseconds since the recorder started.
+     */
+    struct TraceEvent
+    {
+        const char *name        { nullptr };
+        const char *category    { nullptr };
+        int64_t     start       { 0 };
+        int64_t     duration    { 0 };
+        uint64_t    id          { 0 };
+    };
+
+    /**
+     * @brief A fixed size buffer that only a single thread ever writes to.
+     */
+    struct TraceBuffer
+    {
+        explicit TraceBuffer(uint32_t threadId);
+
+        std::unique_ptr<TraceEvent[]>   events;
+        std::atomic<uint64_t>           count       { 0 };
+        std::atomic<uint64_t>           dropped     { 0 };
+        const uint32_t                  threadId;
+    };
+
+    /**
+     * @brief Records scoped events from any thread and writes them out in Chrome's trace_event format
+     * (chrome://tracing or ui.perfetto.dev). Each thread writes into its own buffer so recording never locks.
+     * Events are dropped once a threads buffer is full (ECS_TRACE_BUFFER_SIZE).
+     * @author Ryan Purse
+     * @date 17/10/2026
+     */
+    class TraceRecorder
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        /**
+         * @brief Records a complete event for the calling thread.
+         * @param name - The name of the event. Must outlive the recorder (use string literals).
+         * @param category - The category of the event. Must outlive the recorder (use string literals).
+         * @param start - When the event started.
+         * @param end - When the event ended.
+         * @param id - An optional id shown with the event (E.g.: the address of a system).
+         */
+        static void record(const char *name, const char *category, Clock::time_point start, Clock::time_point end, uint64_t id=0);
+
+        /**
+         * @brief Writes every recorded event as a Chrome trace_event JSON object.
+         * @param stream - The stream that you want to write to.
+         */
+        static void write(std::ostream &stream);
+
+        /**
+         * @brief Removes all recorded events. No other thread may be recording while this is called.
+         */
+        static void clear();
+
+    protected:
+        /**
+         * @returns The buffer of the calling thread. Creates one the first time a thread records.
+         */
+        static TraceBuffer &threadBuffer();
+    };
+
+    /**
+     * @brief Records an event that lasts for as long as the scope it is in. Use ECS_TRACE_SCOPE instead.
+     */
+    class TraceScope
+    {
+    public:
+        TraceScope(const char *name, const char *category, uint64_t id=0)
+            : mName(name), mCategory(category), mId(id), mStart(TraceRecorder::Clock::now())
+        {
+        }
+
+        ~TraceScope()
+        {
+            TraceRecorder::record(mName, mCategory, mStart, TraceRecorder::Clock::now(), mId);
+        }
+
+        TraceScope(const TraceScope &) = delete;
+        TraceScope &operator=(const TraceScope &) = delete;
+
+    protected:
+        const char                      *mName;
+        const char                      *mCategory;
+        const uint64_t                  mId;
+        const TraceRecorder::Clock::time_point mStart;
+    };
+}
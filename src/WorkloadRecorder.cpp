@@ -0,0 +1,78 @@
+/**
+ * @file WorkloadRecorder.cpp
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#include "WorkloadRecorder.h"
+
+namespace ecs
+{
+    WorkloadRecorder::WorkloadRecorder(const std::string &path)
+        : mStream(path, std::ios::binary | std::ios::trunc)
+    {
+        if (!mStream)
+            throw std::exception();  // Unable to open the file for writing.
+
+        mStream.write(magic, sizeof(magic));
+        write(version);
+    }
+
+    void WorkloadRecorder::recordCreateEntity(Entity entity)
+    {
+        write(workloadOp::CreateEntity);
+        write(entity);
+    }
+
+    void WorkloadRecorder::recordCreateComponent(Component component, uint32_t size, bool typeDefault)
+    {
+        write(workloadOp::CreateComponent);
+        write(component);
+        write(size);
+        write(typeDefault ? workloadFlag::TypeDefault : workloadFlag::None);
+    }
+
+    void WorkloadRecorder::recordAdd(Entity entity, Component component, const void *data, uint32_t size, bool trivial)
+    {
+        write(workloadOp::Add);
+        write(entity);
+        write(component);
+        write(size);
+        write(trivial ? workloadFlag::HasData : workloadFlag::None);
+        if (trivial)
+            mStream.write(static_cast<const char*>(data), size);
+    }
+
+    void WorkloadRecorder::recordRemove(Entity entity, Component component)
+    {
+        write(workloadOp::Remove);
+        write(entity);
+        write(component);
+    }
+
+    void WorkloadRecorder::recordDestroy(Entity entity)
+    {
+        write(workloadOp::Destroy);
+        write(entity);
+    }
+
+    void WorkloadRecorder::recordGetComponent(Entity entity, Component component)
+    {
+        write(workloadOp::GetComponent);
+        write(entity);
+        write(component);
+    }
+
+    void WorkloadRecorder::recordSetEnabled(Entity entity, bool enabled)
+    {
+        write(workloadOp::SetEnabled);
+        write(entity);
+        write(static_cast<uint8_t>(enabled));
+    }
+
+    void WorkloadRecorder::recordPhase(workloadOp::op phase)
+    {
+        write(phase);
+    }
+}
@@ -0,0 +1,122 @@
+/**
+ * @file WorkloadRecorder.h
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#pragma once
+
+#include "Common.h"
+
+#include <fstream>
+#include <string>
+
+namespace ecs
+{
+    /** The operations that can be recorded. Stored as a single byte at the start of each record. */
+    namespace workloadOp
+    {
+        enum op : uint8_t
+        {
+            /** entity */
+            CreateEntity,
+
+            /** component, size (uint32), flags (uint8) */
+            CreateComponent,
+
+            /** entity, component, size (uint32), flags (uint8), data (size bytes when flags has HasData) */
+            Add,
+
+            /** entity, component */
+            Remove,
+
+            /** entity */
+            Destroy,
+
+            /** entity, component */
+            GetComponent,
+
+            FixedUpdate,
+            Update,
+            Render,
+            ImGui,
+
+            /** entity, enabled (uint8) */
+            SetEnabled,
+
+            Count
+        };
+    }
+
+    namespace workloadFlag
+    {
+        enum flag : uint8_t
+        {
+            None        = 0b0,
+
+            /** The component was made the default for its type (creationType::TypeDefault). */
+            TypeDefault = 0b1,
+
+            /** The component's bytes were recorded. Only trivially copyable components are recorded. */
+            HasData     = 0b10,
+        };
+    }
+
+    /**
+     * @brief Writes every call made to a Core into a compact binary file so that it can be replayed later with
+     * WorkloadReplayer. Values are written in the machine's native byte order.
+     * File layout: "ECSW", version (uint32), then one record per call (see workloadOp).
+     * @author Ryan Purse
+     * @date 17/10/2026
+     */
+    class WorkloadRecorder
+    {
+    public:
+        /** Written at the start of every file. */
+        static constexpr char magic[4] { 'E', 'C', 'S', 'W' };
+        static constexpr uint32_t version { 1 };
+
+        /**
+         * @brief Opens path for writing. Throws if the file could not be opened.
+         * @param path - The file that you want to record to. Overwritten if it already exists.
+         */
+        explicit WorkloadRecorder(const std::string &path);
+
+        void recordCreateEntity(Entity entity);
+
+        void recordCreateComponent(Component component, uint32_t size, bool typeDefault);
+
+        /**
+         * @param data - The bytes of the component. Only written when trivial is true.
+         * @param size - sizeof the component.
+         * @param trivial - Whether the component can be copied byte by byte.
+         */
+        void recordAdd(Entity entity, Component component, const void *data, uint32_t size, bool trivial);
+
+        void recordRemove(Entity entity, Component component);
+
+        void recordDestroy(Entity entity);
+
+        void recordGetComponent(Entity entity, Component component);
+
+        void recordSetEnabled(Entity entity, bool enabled);
+
+        /**
+         * @param phase - One of FixedUpdate, Update, Render or ImGui.
+         */
+        void recordPhase(workloadOp::op phase);
+
+    protected:
+        template<typename T>
+        void write(const T &value);
+
+        std::ofstream mStream;
+    };
+
+    template<typename T>
+    void WorkloadRecorder::write(const T &value)
+    {
+        mStream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+}
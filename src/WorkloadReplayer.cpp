@@ -0,0 +1,230 @@
+/**
+ * @file WorkloadReplayer.cpp
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#include "WorkloadReplayer.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+namespace ecs
+{
+    namespace
+    {
+        /**
+         * @brief Reads values out of a loaded file. Throws if the file ends early.
+         */
+        class Reader
+        {
+        public:
+            explicit Reader(const std::vector<uint8_t> &bytes) : mBytes(bytes) {}
+
+            template<typename T>
+            T read()
+            {
+                T value;
+                std::memcpy(&value, skip(sizeof(T)), sizeof(T));
+                return value;
+            }
+
+            const uint8_t *skip(uint64_t size)
+            {
+                if (mPosition + size > mBytes.size())
+                    throw std::exception();  // The file is truncated.
+                const uint8_t *out = mBytes.data() + mPosition;
+                mPosition += size;
+                return out;
+            }
+
+            [[nodiscard]] bool finished() const { return mPosition >= mBytes.size(); }
+
+        protected:
+            const std::vector<uint8_t> &mBytes;
+            uint64_t mPosition { 0 };
+        };
+    }
+
+    WorkloadReplayer::WorkloadReplayer(const std::string &path)
+    {
+        std::ifstream stream(path, std::ios::binary);
+        if (!stream)
+            throw std::exception();  // Unable to open the file.
+        const std::vector<uint8_t> bytes { std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>() };
+
+        Reader reader(bytes);
+        if (std::memcmp(reader.skip(sizeof(WorkloadRecorder::magic)), WorkloadRecorder::magic, sizeof(WorkloadRecorder::magic)) != 0)
+            throw std::exception();  // Not a workload file.
+        if (reader.read<uint32_t>() != WorkloadRecorder::version)
+            throw std::exception();  // Recorded with a different version.
+
+        while (!reader.finished())
+        {
+            Record record;
+            record.op = static_cast<workloadOp::op>(reader.read<uint8_t>());
+            switch (record.op)
+            {
+                case workloadOp::CreateEntity:
+                case workloadOp::Destroy:
+                    record.entity = reader.read<Entity>();
+                    break;
+                case workloadOp::CreateComponent:
+                    record.component = reader.read<Component>();
+                    record.size = reader.read<uint32_t>();
+                    record.flags = reader.read<uint8_t>();
+                    break;
+                case workloadOp::Add:
+                    record.entity = reader.read<Entity>();
+                    record.component = reader.read<Component>();
+                    record.size = reader.read<uint32_t>();
+                    record.flags = reader.read<uint8_t>();
+                    if (record.flags & workloadFlag::HasData)
+                    {
+                        const uint8_t *data = reader.skip(record.size);
+                        record.dataOffset = mData.size();
+                        mData.insert(mData.end(), data, data + record.size);
+                    }
+                    break;
+                case workloadOp::Remove:
+                case workloadOp::GetComponent:
+                    record.entity = reader.read<Entity>();
+                    record.component = reader.read<Component>();
+                    break;
+                case workloadOp::FixedUpdate:
+                case workloadOp::Update:
+                case workloadOp::Render:
+                case workloadOp::ImGui:
+                    break;
+                case workloadOp::SetEnabled:
+                    record.entity = reader.read<Entity>();
+                    record.flags = reader.read<uint8_t>();
+                    break;
+                default:
+                    throw std::exception();  // Unknown operation. The file is corrupt.
+            }
+            mRecords.push_back(record);
+        }
+    }
+
+    WorkloadTimings WorkloadReplayer::replay(Core &core)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        mEntities.clear();
+        mComponents.clear();
+
+        // Stops the compiler from removing getComponent().
+        volatile uint8_t sink = 0;
+
+        WorkloadTimings timings;
+        for (const Record &record : mRecords)
+        {
+            const auto start = Clock::now();
+            switch (record.op)
+            {
+                case workloadOp::CreateEntity:
+                    mEntities[record.entity] = core.create();
+                    break;
+                case workloadOp::CreateComponent:
+                    findComponent(core, record);
+                    break;
+                case workloadOp::Add:
+                {
+                    const Component component = findComponent(core, record);
+                    const uint8_t *data = (record.flags & workloadFlag::HasData) ? mData.data() + record.dataOffset : nullptr;
+                    mHandlers.at(record.component).add(core, mEntities.at(record.entity), component, data);
+                    break;
+                }
+                case workloadOp::Remove:
+                    core.remove(mEntities.at(record.entity), findComponent(core, record));
+                    break;
+                case workloadOp::Destroy:
+                    core.destroy(mEntities.at(record.entity));
+                    break;
+                case workloadOp::GetComponent:
+                {
+                    const Component component = findComponent(core, record);
+                    sink = sink + mHandlers.at(record.component).get(core, mEntities.at(record.entity), component);
+                    break;
+                }
+                case workloadOp::FixedUpdate:
+                    core.fixedUpdate();
+                    break;
+                case workloadOp::Update:
+                    core.update();
+                    break;
+                case workloadOp::Render:
+                    core.render();
+                    break;
+                case workloadOp::ImGui:
+                    core.imGui();
+                    break;
+                case workloadOp::SetEnabled:
+                    core.setEnabled(mEntities.at(record.entity), record.flags != 0);
+                    break;
+                default:
+                    break;
+            }
+            const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);
+            timings.time[record.op] += elapsed;
+            ++timings.count[record.op];
+            timings.total += elapsed;
+        }
+
+        return timings;
+    }
+
+    Component WorkloadReplayer::findComponent(Core &core, const Record &record)
+    {
+        const auto it = mComponents.find(record.component);
+        if (it != mComponents.end())
+            return it->second;
+
+        // Components that were made implicitly (e.g. add(entity, value)) are only seen when they are first used.
+        if (mHandlers.count(record.component) == 0)
+            mHandlers.emplace(record.component, makeRawHandler(record.size));
+
+        const creationType flag = (record.op == workloadOp::CreateComponent && (record.flags & workloadFlag::TypeDefault))
+                                  ? TypeDefault : Default;
+        const Component component = mHandlers.at(record.component).create(core, flag);
+        mComponents.emplace(record.component, component);
+        return component;
+    }
+
+    template<uint32_t Size>
+    WorkloadReplayer::ComponentHandler WorkloadReplayer::makeSizedHandler(uint32_t size)
+    {
+        const uint32_t copySize = std::min(size, Size);
+        return {
+            [](Core &core, creationType flag) -> Component {
+                return core.create<RawComponent<Size>>(flag);
+            },
+            [copySize](Core &core, Entity entity, Component component, const uint8_t *data) {
+                RawComponent<Size> value {};
+                if (data)
+                    std::memcpy(value.bytes, data, copySize);
+                core.add(entity, component, value);
+            },
+            [](Core &core, Entity entity, Component component) -> uint8_t {
+                return core.getComponent<RawComponent<Size>>(entity, component).bytes[0];
+            }
+        };
+    }
+    
+    WorkloadReplayer::ComponentHandler WorkloadReplayer::makeRawHandler(uint32_t size)
+    {
+        // Rounded up so that only a handful of types need to exist. Anything larger is capped.
+        if (size <= 8)      return makeSizedHandler<8>(size);
+        if (size <= 16)     return makeSizedHandler<16>(size);
+        if (size <= 32)     return makeSizedHandler<32>(size);
+        if (size <= 64)     return makeSizedHandler<64>(size);
+        if (size <= 128)    return makeSizedHandler<128>(size);
+        if (size <= 256)    return makeSizedHandler<256>(size);
+        if (size <= 512)    return makeSizedHandler<512>(size);
+        if (size <= 1024)   return makeSizedHandler<1024>(size);
+        return makeSizedHandler<4096>(size);
+    }
+}
@@ -0,0 +1,156 @@
+/**
+ * @file WorkloadReplayer.h
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#pragma once
+
+#include "Core.h"
+#include "WorkloadRecorder.h"
+
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ecs
+{
+    /**
+     * @brief The time spent on each type of operation while replaying a workload.
+     */
+    struct WorkloadTimings
+    {
+        std::array<std::chrono::nanoseconds, workloadOp::Count> time {};
+        std::array<uint64_t, workloadOp::Count> count {};
+        std::chrono::nanoseconds total { 0 };
+    };
+
+    /**
+     * @brief Replays a file made by Core::startRecording() against a Core and times every call.
+     * Components are replayed with the types registered with registerComponent(). Any other component is replayed
+     * as a block of bytes of (roughly) the same size so that the memory traffic stays about the same.
+     * Systems are not recorded, create them on the Core before replaying if you want phases to do any work.
+     * @author Ryan Purse
+     * @date 17/10/2026
+     */
+    class WorkloadReplayer
+    {
+    public:
+        /**
+         * @brief Loads and decodes the whole file up front so that reading it is not part of the timings.
+         * Throws if the file can't be opened or isn't a workload.
+         * @param path - The file made by Core::startRecording().
+         */
+        explicit WorkloadReplayer(const std::string &path);
+
+        /**
+         * @brief Replays a recorded component using type T. T must be trivially copyable if it was recorded with data.
+         * @tparam T - The type that the component had when it was recorded.
+         * @param recordedComponent - The component Id that was recorded.
+         */
+        template<typename T>
+        void registerComponent(Component recordedComponent);
+
+        /**
+         * @brief Performs every recorded call on core.
+         * @param core - A Core that has not been used yet (other than creating systems).
+         * @returns The time spent on each operation.
+         */
+        WorkloadTimings replay(Core &core);
+
+        /**
+         * @returns The number of recorded calls.
+         */
+        [[nodiscard]] uint64_t size() const { return mRecords.size(); }
+
+    protected:
+        struct Record
+        {
+            workloadOp::op  op          { workloadOp::Update };
+            uint8_t         flags       { workloadFlag::None };
+            uint32_t        size        { 0 };
+            Entity          entity      { 0 };
+            Component       component   { 0 };
+            uint64_t        dataOffset  { 0 };
+        };
+
+        /**
+         * @brief How to create, add and get a component without knowing its type.
+         */
+        struct ComponentHandler
+        {
+            std::function<Component(Core&, creationType)>                   create;
+            std::function<void(Core&, Entity, Component, const uint8_t*)>   add;
+            std::function<uint8_t(Core&, Entity, Component)>                get;
+        };
+
+        /**
+         * @returns A handler that stores components as a block of bytes that is at least size bytes large.
+         */
+        static ComponentHandler makeRawHandler(uint32_t size);
+        
+        /**
+         * @returns A handler that stores components as RawComponent<Size>, copying size bytes into it.
+         */
+        template<uint32_t Size>
+        static ComponentHandler makeSizedHandler(uint32_t size);
+
+        template<typename T>
+        static ComponentHandler makeHandler();
+
+        /**
+         * @returns The replayed component Id of a recorded component. Creates one if it doesn't exist yet.
+         */
+        Component findComponent(Core &core, const Record &record);
+
+        std::vector<Record>                                 mRecords;
+        std::vector<uint8_t>                                mData;
+        std::unordered_map<Component, ComponentHandler>     mHandlers;
+
+        // Recorded Id -> replayed Id. Only valid during replay().
+        std::unordered_map<Entity, Entity>                  mEntities;
+        std::unordered_map<Component, Component>            mComponents;
+    };
+
+    /**
+     * @brief A component of Size bytes. Used to replay components whose type isn't known.
+     */
+    template<uint32_t Size>
+    struct RawComponent
+    {
+        uint8_t bytes[Size];
+    };
+
+    template<typename T>
+    void WorkloadReplayer::registerComponent(Component recordedComponent)
+    {
+        mHandlers[recordedComponent] = makeHandler<T>();
+    }
+
+    template<typename T>
+    WorkloadReplayer::ComponentHandler WorkloadReplayer::makeHandler()
+    {
+        return {
+            [](Core &core, creationType flag) -> Component {
+                return core.create<T>(flag);
+            },
+            [](Core &core, Entity entity, Component component, const uint8_t *data) {
+                T value {};
+                if constexpr (std::is_trivially_copyable_v<T>)
+                {
+                    if (data)
+                        std::memcpy(&value, data, sizeof(T));
+                }
+                core.add(entity, component, value);
+            },
+            [](Core &core, Entity entity, Component component) -> uint8_t {
+                return *reinterpret_cast<const uint8_t*>(&core.getComponent<T>(entity, component));
+            }
+        };
+    }
+}
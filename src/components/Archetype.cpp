@@ -7,6 +7,8 @@
 
 #include "Archetype.h"
 #include "ComponentArray.h"
+#include "DynamicComponentArray.h"
+#include "MemoryUsage.h"
 
 namespace ecs
 {
@@ -32,6 +34,7 @@ namespace ecs
     uint64_t Archetype::transferTo(Archetype &newArchetype, uint64_t dataIndex)
     {
         uint64_t movedIndex = 0;
+        uint64_t count = 0;
         for (const auto &[id, index] : mIdToComponentIndex)
         {
             // Get both component arrays that are the same type.
@@ -39,8 +42,15 @@ namespace ecs
             auto *newIComponentArray = newArchetype.mComponents[newArchetype.mIdToComponentIndex.at(id)].get();
         
             movedIndex = oldIComponentArray->transferItemTo(newIComponentArray, dataIndex);
+            count = newIComponentArray->count();
             // Note: This can be used as a check to see if there's parity between all arrays.
         }
+        
+        // A disabled entity stays disabled in its new archetype.
+        if (!isEnabled(dataIndex))
+            newArchetype.setEnabled(count - 1, false);
+        removeEnabled(dataIndex, movedIndex);
+        
         return movedIndex;
     }
     
@@ -55,18 +65,156 @@ namespace ecs
             auto *oldIComponentArray = oldArchetype.mComponents[oldArchetype.mIdToComponentIndex.at(id)].get();
     
             movedIndex = oldIComponentArray->transferItemTo(newIComponentArray, dataIndex);
-            count = oldIComponentArray->count();
+            count = newIComponentArray->count();
             // Note: This can be used as a check to see if there's parity between all arrays.
         }
+        
+        if (!oldArchetype.isEnabled(dataIndex))
+            setEnabled(count - 1, false);
+        oldArchetype.removeEnabled(dataIndex, movedIndex);
+        
         return { movedIndex, count };
     }
     
     Archetype::~Archetype() = default;
     
+    void Archetype::createComponentArray(Component id, const ComponentLayout &layout)
+    {
+        mComponents.emplace_back(std::make_unique<DynamicComponentArray>(layout));
+        mIdToComponentIndex[id] = mComponents.size() - 1;
+    }
+    
+    uint64_t Archetype::pushBackRaw(Component id, const void *value)
+    {
+        // This may not throw an error when casting. Make sure that id was created with a layout.
+        auto * const componentArray = static_cast<DynamicComponentArray*>(mComponents[mIdToComponentIndex.at(id)].get());
+        return componentArray->pushBack(value);
+    }
+    
+    uint64_t Archetype::pushBackRaw(Component id, const void *values, uint64_t count)
+    {
+        // This may not throw an error when casting. Make sure that id was created with a layout.
+        auto * const componentArray = static_cast<DynamicComponentArray*>(mComponents[mIdToComponentIndex.at(id)].get());
+        return componentArray->pushBack(values, count);
+    }
+    
+    uint64_t Archetype::getColumnIndex(Component component) const
+    {
+        return mIdToComponentIndex.at(component);
+    }
+    
+    void *Archetype::getComponentData(Component component, uint64_t index) const
+    {
+        IComponentArray &componentArray = *mComponents[mIdToComponentIndex.at(component)];
+        return static_cast<std::byte*>(componentArray.rawData()) + index * componentArray.elementSize();
+    }
+    
     void Archetype::moveLastComponent(Component component, uint64_t index)
     {
         mComponents[mIdToComponentIndex.at(component)]->moveLastItem(index);
     }
+    
+    uint64_t Archetype::removeRow(uint64_t index)
+    {
+        for (const std::unique_ptr<IComponentArray> &componentArray : mComponents)
+            componentArray->moveLastItem(index);
+        
+        const uint64_t movedIndex = count();
+        removeEnabled(index, movedIndex);
+        return movedIndex;
+    }
+    
+    void Archetype::setEnabled(uint64_t index, bool enabled)
+    {
+        const uint64_t word = index / 64;
+        const uint64_t bit = uint64_t(1) << (index % 64);
+        if (isEnabled(index) == enabled)
+            return;
+        
+        if (word >= mDisabled.size())
+            mDisabled.resize(word + 1, 0);  // Only reached when disabling.
+        
+        mDisabled[word] ^= bit;
+        if (enabled)
+            --mDisabledCount;
+        else
+            ++mDisabledCount;
+    }
+    
+    bool Archetype::isEnabled(uint64_t index) const
+    {
+        const uint64_t word = index / 64;
+        return word >= mDisabled.size() || !(mDisabled[word] & (uint64_t(1) << (index % 64)));
+    }
+    
+    void Archetype::removeEnabled(uint64_t index, uint64_t movedIndex)
+    {
+        const bool movedEnabled = isEnabled(movedIndex);
+        setEnabled(movedIndex, true);  // The last row no longer exists.
+        if (index != movedIndex)
+            setEnabled(index, movedEnabled);
+    }
+    
+    uint64_t Archetype::count() const
+    {
+        // All component arrays always have the same number of elements.
+        return mComponents.empty() ? 0 : mComponents[0]->count();
+    }
+    
+    void Archetype::reserve(uint64_t capacity)
+    {
+        for (const std::unique_ptr<IComponentArray> &componentArray : mComponents)
+            componentArray->reserve(capacity);
+    }
+    
+    void Archetype::setGrowthPolicy(const GrowthPolicy &policy)
+    {
+        mGrowthPolicy = policy;
+        for (const std::unique_ptr<IComponentArray> &componentArray : mComponents)
+            componentArray->setGrowthPolicy(policy);
+    }
+    
+    uint64_t Archetype::getReservedBytes() const
+    {
+        uint64_t bytes = 0;
+        for (const auto &componentArray : mComponents)
+            bytes += componentArray->capacity() * componentArray->elementSize();
+        return bytes;
+    }
+    
+    void Archetype::recordIteration(uint64_t rowCount, const HardwareCounters &counters)
+    {
+        mCounterStatistics.rowsIterated += rowCount;
+        mCounterStatistics.counters += counters;
+    }
+    
+    ArchetypeMemoryStatistics Archetype::getMemoryStatistics(const Type &type, const HugePageMap &hugePages) const
+    {
+        ArchetypeMemoryStatistics statistics;
+        statistics.type = type;
+        statistics.bytesOverhead = memoryUsage::of(mIdToComponentIndex) + memoryUsage::of(mComponents)
+            + memoryUsage::of(mDisabled);
+        
+        for (const Component component : type)
+        {
+            const IComponentArray &componentArray = *mComponents[mIdToComponentIndex.at(component)];
+            const uint64_t elementSize = componentArray.elementSize();
+            
+            statistics.rowCount = componentArray.count();
+            statistics.columns.push_back({
+                component, elementSize, componentArray.count() * elementSize, componentArray.capacity() * elementSize,
+                componentArray.getHugePageBytes(hugePages)
+            });
+            statistics.bytesUsed += statistics.columns.back().bytesUsed;
+            statistics.bytesReserved += statistics.columns.back().bytesReserved;
+            statistics.bytesInHugePages += statistics.columns.back().bytesInHugePages;
+            
+            // The array object itself is always allocated (vtable + vector).
+            statistics.bytesOverhead += sizeof(ComponentArray<char>);
+        }
+        
+        return statistics;
+    }
 }
 
 
@@ -9,7 +9,10 @@
 
 #include "Common.h"
 #include "ComponentArray.h"
+#include "ComponentLayout.h"
+#include "GrowthPolicy.h"
 #include "BaseSystem.h"
+#include "Statistics.h"
 
 #include <iostream>
 #include <vector>
@@ -17,6 +20,7 @@
 #include <memory>
 #include <unordered_map>
 #include <algorithm>
+#include <type_traits>
 
 namespace ecs
 {
@@ -68,14 +72,21 @@ namespace ecs
         void createComponentArray(Component id, const Components &... args);
         
         /**
-         * @brief Adds a component value to the end of the desired component array.
+         * @brief Creates a component array within the archetype for a component that was defined at runtime.
+         * @param id - The Id given to the component.
+         * @param layout - How the component is laid out. Must outlive the archetype.
+         */
+        void createComponentArray(Component id, const ComponentLayout &layout);
+        
+        /**
+         * @brief Adds a component value to the end of the desired component array. It is moved if it is an rvalue.
          * @tparam T - The type that value is.
          * @param id - The Id given to the component.
          * @param value - The actual data that you want to store.
          * @returns The index of where it's stored.
          */
         template<typename T>
-        uint64_t pushBack(Component id, const T &value);
+        uint64_t pushBack(Component id, T &&value);
     
         /**
          * @brief Adds component values to all of the desired component arrays.
@@ -87,7 +98,35 @@ namespace ecs
          * @returns The index of where it's stored.
          */
         template<typename T, typename ...Args>
-        uint64_t pushBack(Component id, const T &value, const Args &... values);
+        uint64_t pushBack(Component id, T &&value, Args &&... values);
+        
+        /**
+         * @brief Constructs a component at the end of the desired component array without copying or moving it.
+         * @tparam T - The type of component.
+         * @tparam Args - The types of args.
+         * @param id - The Id given to the component.
+         * @param args - The arguments passed into the constructor of T, or its members in order if T is an aggregate.
+         * @returns The index of where it's stored.
+         */
+        template<typename T, typename ...Args>
+        uint64_t emplaceBack(Component id, Args &&... args);
+        
+        /**
+         * @brief Adds a component to the end of a component array that was created with a ComponentLayout.
+         * @param id - The Id given to the component.
+         * @param value - The bytes of the component. It is constructed (or zeroed) if nullptr.
+         * @returns The index of where it's stored.
+         */
+        uint64_t pushBackRaw(Component id, const void *value);
+        
+        /**
+         * @brief Adds count components to the end of a component array that was created with a ComponentLayout.
+         * @param id - The Id given to the component.
+         * @param values - count components packed layout.size bytes apart. They are constructed (or zeroed) if nullptr.
+         * @param count - The number of components to add.
+         * @returns The index of the first new component.
+         */
+        uint64_t pushBackRaw(Component id, const void *values, uint64_t count);
     
         /**
          * @brief Gets an element within a single component array.
@@ -97,6 +136,33 @@ namespace ecs
          */
         template<typename T>
         T &getComponent(Component component, uint64_t index) const;
+        
+        /**
+         * @param component - The component array id.
+         * @returns Where the component array is stored within this archetype. Never changes once created.
+         */
+        [[nodiscard]] uint64_t getColumnIndex(Component component) const;
+        
+        /**
+         * @brief Gets the first element of a component array. The rest follow every getColumnStride(index) bytes.
+         * WARNING: Invalidated when the archetype grows. There is no bounds checking.
+         * @param index - The column index (getColumnIndex()) of the component array.
+         * @returns The first element of the component array.
+         */
+        [[nodiscard]] void *getColumn(uint64_t index) const { return mComponents[index]->rawData(); }
+        
+        /**
+         * @param index - The column index (getColumnIndex()) of the component array.
+         * @returns The number of bytes between each element of the component array.
+         */
+        [[nodiscard]] uint64_t getColumnStride(uint64_t index) const { return mComponents[index]->elementSize(); }
+        
+        /**
+         * @brief Gets an element within a single component array without knowing its type.
+         * @param component - The component array id.
+         * @param index - The retrieved values index.
+         */
+        [[nodiscard]] void *getComponentData(Component component, uint64_t index) const;
     
         /**
          * @brief Moves data at dataIndex into newArchetype. The newArchetype MUST be equal or larger to this archetype.
@@ -161,19 +227,120 @@ namespace ecs
          * @param index - The index you want to move the last item to.
          */
         void moveLastComponent(Component component, uint64_t index);
+        
+        /**
+         * @brief Removes the data at index from every component array by moving the last item into it.
+         * @param index - The index of the data you want to remove.
+         * @returns The index of the element that was moved to the index passed in.
+         */
+        [[nodiscard]] uint64_t removeRow(uint64_t index);
+        
+        /**
+         * @brief Marks a row so that iteration skips it (or no longer skips it). Nothing is moved.
+         * @param index - The index of the row.
+         * @param enabled - Whether the row should be iterated over.
+         */
+        void setEnabled(uint64_t index, bool enabled);
+        
+        /**
+         * @param index - The index of the row.
+         * @returns False if the row has been disabled with setEnabled().
+         */
+        [[nodiscard]] bool isEnabled(uint64_t index) const;
+        
+        /**
+         * @returns The number of rows that iteration skips.
+         */
+        [[nodiscard]] uint64_t getDisabledCount() const { return mDisabledCount; }
+        
+        /**
+         * @brief Calls function with every run of enabled rows below count. Disabled rows are skipped 64 at a time.
+         * @tparam Function - void(uint64_t begin, uint64_t end).
+         * @param count - The number of rows to look at.
+         * @param function - Called with the rows [begin, end) of each run.
+         */
+        template<typename Function>
+        void forEachEnabledRange(uint64_t count, Function &&function) const;
+        
+        /**
+         * @brief Gets how much memory each component array is using.
+         * @param type - The type of this archetype.
+         * @param hugePages - Where transparent huge pages are. Read once per report.
+         * @returns The memory used by this archetype and each of its component arrays.
+         */
+        [[nodiscard]] ArchetypeMemoryStatistics getMemoryStatistics(const Type &type, const HugePageMap &hugePages) const;
+        
+        /**
+         * @returns The number of entities stored in this archetype.
+         */
+        [[nodiscard]] uint64_t count() const;
+        
+        /**
+         * @returns The bytes reserved by every component array. Cheaper than getMemoryStatistics().
+         */
+        [[nodiscard]] uint64_t getReservedBytes() const;
+        
+        /**
+         * @brief Makes sure that capacity rows can be stored without any component array reallocating.
+         * @param capacity - The number of rows.
+         */
+        void reserve(uint64_t capacity);
+        
+        /**
+         * @brief Sets how much the component arrays grow by when they run out of room.
+         * @param policy - The policy that you want to use from now on.
+         */
+        void setGrowthPolicy(const GrowthPolicy &policy);
+        
+        [[nodiscard]] const GrowthPolicy &getGrowthPolicy() const { return mGrowthPolicy; }
+        
+        /**
+         * @brief Adds to the hardware counters recorded while iterating over this archetype.
+         * @param rowCount - The number of rows that were iterated over.
+         * @param counters - The counters that happened while iterating.
+         */
+        void recordIteration(uint64_t rowCount, const HardwareCounters &counters);
+        
+        /**
+         * @returns Everything recorded by recordIteration().
+         */
+        [[nodiscard]] const ArchetypeCounterStatistics &getCounterStatistics() const { return mCounterStatistics; }
 
     protected:
         /**
-         * @brief Get the component vector T by using an id. WARNING: There is no bounds checking.
+         * @brief Get the component storage of T by using an id. WARNING: There is no bounds checking.
          * @tparam T - The type of component array that you want to get.
          * @param id - The index of the component array within components
-         * @returns A vector of type T.
+         * @returns The storage of every T.
          */
         template<typename T>
-        [[nodiscard]] std::vector<T> *get(Component id) const;
+        [[nodiscard]] ColumnStorage<T> *get(Component id) const;
         
+        /**
+         * @brief Keeps the disabled rows in step with a row being removed by moving the last row into it.
+         * @param index - The index of the removed row.
+         * @param movedIndex - The index the last row was moved from.
+         */
+        void removeEnabled(uint64_t index, uint64_t movedIndex);
+        
+        /**
+         * @returns The index of the lowest set bit in value. value must not be zero.
+         */
+        [[nodiscard]] static uint64_t lowestBit(uint64_t value);
+        
+
         std::unordered_map<Component, uint64_t> mIdToComponentIndex;
         std::vector<std::unique_ptr<IComponentArray>> mComponents;
+        
+        // The type is filled in by the archetype manager when reporting.
+        ArchetypeCounterStatistics mCounterStatistics;
+        
+        GrowthPolicy mGrowthPolicy;
+        
+        /** One bit per row, set if the row is disabled. Bits past the last row are always clear. */
+        std::vector<uint64_t> mDisabled;
+        
+        uint64_t mDisabledCount { 0 };
     };
     
     template<typename T>
@@ -191,23 +358,29 @@ namespace ecs
     }
     
     template<typename T>
-    uint64_t Archetype::pushBack(Component id, const T &value)
+    uint64_t Archetype::pushBack(Component id, T &&value)
     {
-        std::vector<T> * const container = get<T>(id);
-        container->push_back(value);
-        return container->size() - 1;  // It is always the last element in the vector.
+        return emplaceBack<std::decay_t<T>>(id, std::forward<T>(value));
     }
     
     template<typename T, typename ...Args>
-    uint64_t Archetype::pushBack(Component id, const T &value, const Args &... values)
+    uint64_t Archetype::pushBack(Component id, T &&value, Args &&... values)
     {
-        const auto index = pushBack(id, value);
-        pushBack(values...);
+        const auto index = pushBack(id, std::forward<T>(value));
+        pushBack(std::forward<Args>(values)...);
         return index;
     }
     
+    template<typename T, typename ...Args>
+    uint64_t Archetype::emplaceBack(Component id, Args &&... args)
+    {
+        ColumnStorage<T> * const container = get<T>(id);
+        container->emplace_back(std::forward<Args>(args)...);
+        return container->size() - 1;  // It is always the last element in the vector.
+    }
+    
     template<typename T>
-    [[nodiscard]] std::vector<T> *Archetype::get(Component id) const
+    [[nodiscard]] ColumnStorage<T> *Archetype::get(Component id) const
     {
         const uint64_t index = mIdToComponentIndex.at(id);
         auto * const componentArray = reinterpret_cast<ComponentArray<T>*>(mComponents[index].get());
@@ -240,8 +413,10 @@ namespace ecs
         // todo: Should this really be a member function.
         std::tuple<ComponentArray<EArgs>*...> arrays = getArraysOfType_s<EArgs...>(entities.mType.begin());
         
-        for (int i = 0; i < std::get<0>(arrays)->data.size(); ++i)
-            entities.invoke(std::forward_as_tuple(std::get<ComponentArray<EArgs>*>(arrays)->data[i]...));
+        forEachEnabledRange(std::get<0>(arrays)->data.size(), [&](uint64_t begin, uint64_t end) {
+            for (uint64_t i = begin; i < end; ++i)
+                entities.invoke(std::forward_as_tuple(std::get<ComponentArray<EArgs>*>(arrays)->data[i]...));
+        });
     }
     
     template<typename ...EArgs, typename ...IArgs>
@@ -250,8 +425,49 @@ namespace ecs
         // todo: This should be a non-member function in Core.h
         // todo: This needs a safety check since it will explode in your face if you pass the wrong items.
         std::tuple<ComponentArray<EArgs>*...> t(reinterpret_cast<ComponentArray<EArgs>*>(mComponents[mIdToComponentIndex.at(ids)].get())...);
-        for (int i = 0; i < std::get<0>(t)->data.size(); ++i)
-            entities.invoke(std::forward_as_tuple(std::get<ComponentArray<EArgs>*>(t)->data[i]...));
+        forEachEnabledRange(std::get<0>(t)->data.size(), [&](uint64_t begin, uint64_t end) {
+            for (uint64_t i = begin; i < end; ++i)
+                entities.invoke(std::forward_as_tuple(std::get<ComponentArray<EArgs>*>(t)->data[i]...));
+        });
+    }
+    
+    template<typename Function>
+    void Archetype::forEachEnabledRange(uint64_t count, Function &&function) const
+    {
+        uint64_t begin = 0;
+        if (mDisabledCount > 0)
+        {
+            const uint64_t wordCount = std::min<uint64_t>(mDisabled.size(), (count + 63) / 64);
+            for (uint64_t word = 0; word < wordCount; ++word)
+            {
+                // Words without a disabled row are skipped whole. Otherwise, each disabled row ends a run.
+                for (uint64_t disabled = mDisabled[word]; disabled != 0; disabled &= disabled - 1)
+                {
+                    const uint64_t row = word * 64 + lowestBit(disabled);
+                    if (row > begin)
+                        function(begin, row);
+                    begin = row + 1;
+                }
+            }
+        }
+        
+        if (begin < count)
+            function(begin, count);
+    }
+    
+    inline uint64_t Archetype::lowestBit(uint64_t value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(value);
+#else
+        uint64_t bit = 0;
+        while (!(value & 1))
+        {
+            value >>= 1;
+            ++bit;
+        }
+        return bit;
+#endif
     }
     
     template<typename T>
@@ -259,4 +475,37 @@ namespace ecs
     {
         return (*get<T>(component))[index];
     }
+    
+    /**
+     * @brief The columns of a single archetype that matched a query. Column i pairs with the i-th component that was
+     * queried for. Used to iterate over components without knowing their types.
+     */
+    struct ColumnChunk
+    {
+        Archetype       *archetype      { nullptr };
+        
+        /** The column index within archetype of each component that was queried for. */
+        const uint64_t  *columnIndices  { nullptr };
+        
+        /** The number of rows in this chunk. */
+        uint64_t        count           { 0 };
+        
+        /** The row within archetype that this chunk starts at. */
+        uint64_t        first           { 0 };
+        
+        /**
+         * @param index - The index of the component within the query.
+         * @returns The first element of that column within this chunk.
+         */
+        [[nodiscard]] void *column(uint64_t index) const
+        {
+            return static_cast<char*>(archetype->getColumn(columnIndices[index])) + first * stride(index);
+        }
+        
+        /**
+         * @param index - The index of the component within the query.
+         * @returns The number of bytes between each element of that column.
+         */
+        [[nodiscard]] uint64_t stride(uint64_t index) const { return archetype->getColumnStride(columnIndices[index]); }
+    };
 }
@@ -6,9 +6,31 @@
 
 
 #include "ArchetypeManager.h"
+#include "MemoryUsage.h"
+
+#include <algorithm>
+#include <iterator>
 
 namespace ecs
 {
+    namespace
+    {
+        void setBit(std::vector<uint64_t> &mask, uint64_t bit)
+        {
+            if (bit / 64 >= mask.size())
+                mask.resize(bit / 64 + 1, 0);
+            mask[bit / 64] |= 1ull << (bit % 64);
+        }
+        
+        /**
+         * @returns The word at index, or zero if signature is not that long.
+         */
+        uint64_t wordOf(const std::vector<uint64_t> &signature, uint64_t index)
+        {
+            return index < signature.size() ? signature[index] : 0;
+        }
+    }
+    
     Archetype* ArchetypeManager::findArchetype(const Type &type)
     {
         // todo: Find a way to inline this since you still need to check if this is nullptr.
@@ -39,12 +61,167 @@ namespace ecs
         return out;
     }
     
+    void ArchetypeManager::updateArchetypesWithSubset(const UType &uType, ArchetypeCache &cache)
+    {
+        for (; cache.checkedCount < mCreationOrder.size(); ++cache.checkedCount)
+        {
+            auto &[key, value] = *mCreationOrder[cache.checkedCount];
+            if (ecs::includes(key, uType))
+                cache.archetypes.push_back(&value);
+        }
+    }
+    
+    void ArchetypeManager::insertArchetype(const Type &type, Archetype &&archetype)
+    {
+        archetype.setGrowthPolicy(mGrowthPolicy);
+        mCreationOrder.push_back(mArchetypes.emplace(type, std::move(archetype)).first);
+        
+        std::vector<uint64_t> &signature = mSignatures.emplace_back();
+        for (const Component component : type)
+            setBit(signature, getComponentBit(component));
+    }
+    
+    uint64_t ArchetypeManager::getComponentBit(Component component)
+    {
+        return mComponentBits.try_emplace(component, mComponentBits.size()).first->second;
+    }
+    
+    void ArchetypeManager::compileQuery(Query &query, const UType &with, const UType &without)
+    {
+        for (const Component component : query.mComponents)
+            setBit(query.mRequired, getComponentBit(component));
+        for (const Component component : with)
+            setBit(query.mRequired, getComponentBit(component));
+        for (const Component component : without)
+            setBit(query.mExcluded, getComponentBit(component));
+    }
+    
+    void ArchetypeManager::updateQuery(Query &query)
+    {
+        for (; query.mCheckedCount < mCreationOrder.size(); ++query.mCheckedCount)
+        {
+            const std::vector<uint64_t> &signature = mSignatures[query.mCheckedCount];
+            
+            bool matches = true;
+            for (uint64_t i = 0; i < query.mRequired.size() && matches; ++i)
+                matches = (wordOf(signature, i) & query.mRequired[i]) == query.mRequired[i];
+            for (uint64_t i = 0; i < query.mExcluded.size() && matches; ++i)
+                matches = (wordOf(signature, i) & query.mExcluded[i]) == 0;
+            if (!matches)
+                continue;
+            
+            Archetype &archetype = mCreationOrder[query.mCheckedCount]->second;
+            query.mArchetypes.push_back(&archetype);
+            for (const Component component : query.mComponents)
+                query.mColumnIndices.push_back(archetype.getColumnIndex(component));
+        }
+    }
+    
+    void ArchetypeManager::add(Entity entity, Component component, const ComponentLayout &layout, const void *value)
+    {
+        const auto it = mEntityInformation.find(entity);
+        if (it == mEntityInformation.end())
+        {
+            createArchetype(component, layout);
+            Archetype * const archetype = findArchetype( { component } );
+            const uint64_t index = archetype->pushBackRaw(component, value);
+            recordTransition(nullptr, archetype, component, true);
+            
+            mEntityInformation.insert( { entity, { { component }, index } } );
+            return;
+        }
+        
+        EntityInformation &info = it->second;
+        Type newType = info.type;
+        newType.emplace(component);
+        
+        Archetype &oldArchetype = *findArchetype(info.type);
+        
+        cloneArchetype(component, info.type, oldArchetype, layout);
+        
+        Archetype &newArchetype = *findArchetype(newType);
+        
+        const uint64_t movedIndex = oldArchetype.transferTo(newArchetype, info.componentIndex);
+        recordTransition(&oldArchetype, &newArchetype, component, true);
+        
+        // Update the moved item's index so that it points to the correct place.
+        entityMovedIndex(info.componentIndex, { info.type, movedIndex });
+        
+        // Add in the new item.
+        info.componentIndex = newArchetype.pushBackRaw(component, value);
+        info.type = newType;
+    }
+    
+    void ArchetypeManager::spawn(const Entity *entities, uint64_t count, const UType &components,
+                                 const std::vector<const ComponentLayout*> &layouts, const void *const *values)
+    {
+        const Type type(components.begin(), components.end());
+        Archetype *archetype = findArchetype(type);
+        if (!archetype)
+        {
+            ECS_TRACE_SCOPE("Create Archetype", "Archetype");
+            Archetype created;
+            for (uint64_t i = 0; i < components.size(); ++i)
+                created.createComponentArray(components[i], *layouts[i]);
+            insertArchetype(type, std::move(created));
+            archetype = findArchetype(type);
+        }
+        
+        uint64_t first = 0;
+        for (uint64_t i = 0; i < components.size(); ++i)
+            first = archetype->pushBackRaw(components[i], values ? values[i] : nullptr, count);
+        
+        mEntityInformation.reserve(mEntityInformation.size() + count);
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            mEntityInformation.insert( { entities[i], { type, first + i } } );
+            recordTransition(nullptr, archetype, components.front(), true);
+        }
+    }
+    
+    void ArchetypeManager::createArchetype(Component id, const ComponentLayout &layout)
+    {
+        if (findArchetype( { id } ))
+            return;  // Archetype already exist, no need to make a new one.
+        
+        ECS_TRACE_SCOPE("Create Archetype", "Archetype");
+        Archetype archetype;
+        archetype.createComponentArray(id, layout);
+        insertArchetype(Type { id }, std::move(archetype));
+    }
+    
+    void ArchetypeManager::cloneArchetype(Component id, const Type &baseType, const Archetype &baseArchetype, const ComponentLayout &layout)
+    {
+        Type newType(baseType);
+        newType.insert(id);
+        if (findArchetype(newType))
+            return;  // Archetype already exists.
+        
+        ECS_TRACE_SCOPE("Create Archetype", "Archetype");
+        Archetype derived(baseArchetype);
+        derived.createComponentArray(id, layout);
+        
+        insertArchetype(newType, std::move(derived));
+    }
+    
+    void *ArchetypeManager::getComponentData(Entity entity, Component component) const
+    {
+        const auto &information = mEntityInformation.at(entity);
+        return mArchetypes.at(information.type).getComponentData(component, information.componentIndex);
+    }
+    
     void ArchetypeManager::remove(Entity entity, Component component)
     {
         EntityInformation &info = mEntityInformation.at(entity);
         Type newType = info.type;
         newType.erase(component);
         
+        if (newType.empty())
+        {
+            destroy(entity);  // Nothing is left, so the entity no longer needs to be stored.
+            return;
+        }
+        
         Archetype &oldArchetype = *findArchetype(info.type);
     
         subCloneArchetype(newType, info.type);
@@ -52,6 +229,7 @@ namespace ecs
         Archetype &newArchetype = *findArchetype(newType);
         
         const auto [moveIndex, count]  = newArchetype.transferFrom(oldArchetype, info.componentIndex);
+        recordTransition(&oldArchetype, &newArchetype, component, false);
         
         // Move the trailing item that won't get picked up by transfer from.
         oldArchetype.moveLastComponent(component, info.componentIndex);
@@ -63,16 +241,102 @@ namespace ecs
         info.type = newType;
     }
     
+    void ArchetypeManager::remove(Entity entity, const Component *components, uint64_t count)
+    {
+        EntityInformation &info = mEntityInformation.at(entity);
+        Type newType = info.type;
+        for (uint64_t i = 0; i < count; ++i)
+            newType.erase(components[i]);
+        
+        if (newType.size() == info.type.size())
+            return;  // The entity had none of them.
+        
+        if (newType.empty())
+        {
+            destroy(entity);  // Nothing is left, so the entity no longer needs to be stored.
+            return;
+        }
+        
+        Archetype &oldArchetype = *findArchetype(info.type);
+        
+        subCloneArchetype(newType, info.type);
+        
+        Archetype &newArchetype = *findArchetype(newType);
+        
+        const auto [moveIndex, newCount] = newArchetype.transferFrom(oldArchetype, info.componentIndex);
+        
+        // Any of components that the entity had will do. The report lists all of them.
+        recordTransition(&oldArchetype, &newArchetype, *std::find_if(info.type.begin(), info.type.end(), [&](Component component) {
+            return !newType.count(component);
+        }), false);
+        
+        // Move the trailing items that won't get picked up by transfer from.
+        for (const Component component : info.type)
+        {
+            if (!newType.count(component))
+                oldArchetype.moveLastComponent(component, info.componentIndex);
+        }
+        
+        entityMovedIndex(info.componentIndex, { info.type, moveIndex } );
+        
+        // Count - 1 is always where the component index will end up.
+        info.componentIndex = newCount - 1;
+        info.type = newType;
+    }
+    
+    void ArchetypeManager::destroy(Entity entity)
+    {
+        const auto it = mEntityInformation.find(entity);
+        if (it == mEntityInformation.end())
+            return;  // The entity doesn't have any components.
+        
+        const EntityInformation info = it->second;
+        mEntityInformation.erase(it);
+        
+        Archetype &archetype = *findArchetype(info.type);
+        const uint64_t movedIndex = archetype.removeRow(info.componentIndex);
+        
+        entityMovedIndex(info.componentIndex, { info.type, movedIndex });
+    }
+    
     void ArchetypeManager::subCloneArchetype(const Type &subType, const Type &baseType)
     {
         if (findArchetype(subType))
             return;  // The subType archetype already exists, we can use that.
         
+        ECS_TRACE_SCOPE("Create Archetype", "Archetype");
         Archetype *base = findArchetype(baseType);
         if (!base)
             throw std::exception();  // No base type has been created yet.
             
-        mArchetypes.emplace(subType, Archetype(*base, subType));
+        insertArchetype(subType, Archetype(*base, subType));
+    }
+    
+    void ArchetypeManager::reserve(const Type &type, uint64_t count)
+    {
+        Archetype *archetype = findArchetype(type);
+        if (!archetype)
+            throw std::exception();  // The archetype has not been created yet.
+        archetype->reserve(count);
+    }
+    
+    void ArchetypeManager::setGrowthPolicy(const GrowthPolicy &policy)
+    {
+        mGrowthPolicy = policy;
+        for (auto &[type, archetype] : mArchetypes)
+        {
+            if (!mCustomGrowthPolicies.count(type))
+                archetype.setGrowthPolicy(policy);
+        }
+    }
+    
+    void ArchetypeManager::setGrowthPolicy(const Type &type, const GrowthPolicy &policy)
+    {
+        Archetype *archetype = findArchetype(type);
+        if (!archetype)
+            throw std::exception();  // The archetype has not been created yet.
+        archetype->setGrowthPolicy(policy);
+        mCustomGrowthPolicies.insert(type);
     }
     
     bool ArchetypeManager::hasComponent(Entity entity, Component component) const
@@ -83,6 +347,112 @@ namespace ecs
         return entityInformation.type.count(component);
     }
     
+    bool ArchetypeManager::hasAnyComponent(Entity entity) const
+    {
+        return mEntityInformation.count(entity);
+    }
+    
+    void ArchetypeManager::setEnabled(Entity entity, bool enabled)
+    {
+        const auto it = mEntityInformation.find(entity);
+        if (it == mEntityInformation.end())
+            throw std::exception();  // The entity doesn't have any components, so there's no row to mark.
+        
+        findArchetype(it->second.type)->setEnabled(it->second.componentIndex, enabled);
+    }
+    
+    bool ArchetypeManager::isEnabled(Entity entity) const
+    {
+        const auto it = mEntityInformation.find(entity);
+        if (it == mEntityInformation.end())
+            return true;
+        return mArchetypes.at(it->second.type).isEnabled(it->second.componentIndex);
+    }
+    
+    void ArchetypeManager::getMemoryStatistics(MemoryReport &report) const
+    {
+        report.archetypeMapBytes += memoryUsage::of(mArchetypes);
+        
+        // Reading smaps is slow, so it's only done once and only when some archetype asked for huge pages.
+        const bool anyHugePages = std::any_of(mArchetypes.begin(), mArchetypes.end(), [](const auto &pair) {
+            return pair.second.getGrowthPolicy().hugePages;
+        });
+        const HugePageMap hugePages = anyHugePages ? HugePageMap::read() : HugePageMap();
+        
+        for (const auto &[type, archetype] : mArchetypes)
+        {
+            report.archetypes.push_back(archetype.getMemoryStatistics(type, hugePages));
+            
+            const ArchetypeMemoryStatistics &statistics = report.archetypes.back();
+            report.archetypeMapBytes += memoryUsage::of(type) + statistics.bytesOverhead;
+            report.totalBytesUsed += statistics.bytesUsed;
+            report.totalBytesReserved += statistics.bytesReserved;
+            report.totalBytesInHugePages += statistics.bytesInHugePages;
+        }
+        
+        report.entityRecordBytes += memoryUsage::of(mEntityInformation);
+        for (const auto &[_, information] : mEntityInformation)
+            report.entityRecordBytes += memoryUsage::of(information.type);
+    }
+    
+    uint64_t ArchetypeManager::getReservedBytes() const
+    {
+        uint64_t bytes = 0;
+        for (const auto &[_, archetype] : mArchetypes)
+            bytes += archetype.getReservedBytes();
+        return bytes;
+    }
+    
+    void ArchetypeManager::getArchetypeStatistics(ArchetypeReport &report) const
+    {
+        for (const auto &[type, archetype] : mArchetypes)
+        {
+            report.archetypes.push_back({ type, archetype.count() });
+            if (report.archetypes.back().rowCount == 0)
+                ++report.emptyArchetypeCount;
+        }
+        
+#ifdef ECS_ENABLE_PROFILING
+        std::unordered_map<const Archetype*, const Type*> archetypeToType;
+        for (const auto &[type, archetype] : mArchetypes)
+            archetypeToType.emplace(&archetype, &type);
+        
+        for (const auto &[archetypes, transition] : mTransitions)
+        {
+            const auto &[from, to] = archetypes;
+            TransitionStatistics statistics {
+                from ? *archetypeToType.at(from) : Type(), *archetypeToType.at(to),
+                transition.component, transition.added, transition.count, { }
+            };
+            
+            // The edge is the difference between the two types, however many components were moved at once.
+            const Type &larger = transition.added ? statistics.to : statistics.from;
+            const Type &smaller = transition.added ? statistics.from : statistics.to;
+            std::set_difference(larger.begin(), larger.end(), smaller.begin(), smaller.end(),
+                                std::inserter(statistics.components, statistics.components.end()));
+            if (statistics.components.size() > 1)
+                statistics.component = 0;
+            
+            report.transitions.push_back(std::move(statistics));
+        }
+        
+        std::sort(report.transitions.begin(), report.transitions.end(), [](const TransitionStatistics &lhs, const TransitionStatistics &rhs) {
+            return lhs.count > rhs.count;
+        });
+#endif
+    }
+    
+    std::vector<ArchetypeCounterStatistics> ArchetypeManager::getCounterStatistics() const
+    {
+        std::vector<ArchetypeCounterStatistics> out;
+        for (const auto &[type, archetype] : mArchetypes)
+        {
+            out.push_back(archetype.getCounterStatistics());
+            out.back().type = type;
+        }
+        return out;
+    }
+    
     bool EntityInformation::operator==(const EntityInformation &rhs) const
     {
         return type == rhs.type &&
@@ -9,7 +9,10 @@
 
 #include "Common.h"
 #include "Archetype.h"
+#include "Query.h"
+#include "TraceRecorder.h"
 
+#include <array>
 #include <iostream>
 #include <unordered_map>
 #include <map>
@@ -39,36 +42,99 @@ namespace ecs
     {
     public:
         /**
-         * @brief Add a component to an entity and takes in the value.
+         * @brief Add a component to an entity and takes in the value. It is moved if it is an rvalue.
          * @tparam T - The type that component is.
          * @param entity - The entity that you want to add it to.
          * @param component - The id of the component.
          * @param value - The actual data you want to add to entity.
          */
         template<typename T>
-        void add(Entity entity, Component component, const T &value);
+        void add(Entity entity, Component component, T &&value);
+        
+        /**
+         * @brief Add a component to an entity by constructing it directly within its new archetype.
+         * @tparam T - The type that component is.
+         * @tparam Args - The types of args.
+         * @param entity - The entity that you want to add it to.
+         * @param component - The id of the component.
+         * @param args - The arguments passed into the constructor of T, or its members in order if T is an aggregate.
+         * @returns The new component. Only valid until the next change.
+         */
+        template<typename T, typename ...Args>
+        T &emplace(Entity entity, Component component, Args &&... args);
+        
+        /**
+         * @brief Add a component that was defined at runtime to an entity.
+         * @param entity - The entity that you want to add it to.
+         * @param component - The id of the component.
+         * @param layout - How the component is laid out. Must outlive this archetype manager.
+         * @param value - The bytes of the component. It is constructed (or zeroed) if nullptr.
+         */
+        void add(Entity entity, Component component, const ComponentLayout &layout, const void *value);
+        
+        /**
+         * @brief Adds several components to an entity by moving it to its final archetype once. No intermediate
+         * archetypes are created. THROWS if the entity already has one of components or one is given twice.
+         * @tparam Ts - The type of each component.
+         * @param entity - The entity that you want to add them to.
+         * @param components - The id of each component, in the same order as values.
+         * @param values - The actual data you want to add to entity. Each is moved if it is an rvalue.
+         */
+        template<typename ...Ts>
+        void add(Entity entity, const std::array<Component, sizeof...(Ts)> &components, Ts &&... values);
+        
+        /**
+         * @brief Puts new entities straight into the archetype with every one of components, without any transitions.
+         * @param entities - count entities that do not have any components yet.
+         * @param count - The number of entities.
+         * @param components - The components that every entity will have. Must not contain duplicates.
+         * @param layouts - The layout of each of components.
+         * @param values - For each component, count values packed layout.size bytes apart. Either can be nullptr to
+         * construct (or zero) them.
+         */
+        void spawn(const Entity *entities, uint64_t count, const UType &components,
+                   const std::vector<const ComponentLayout*> &layouts, const void *const *values);
         
         void remove(Entity entity, Component component);
+        
+        /**
+         * @brief Removes several components from an entity by moving it to its final archetype once. No intermediate
+         * archetypes are created. Components that entity does not have are ignored.
+         * @param entity - The entity that you want to remove them from.
+         * @param components - The components that you want to remove.
+         * @param count - The number of components.
+         */
+        void remove(Entity entity, const Component *components, uint64_t count);
+        
+        /**
+         * @brief Removes all of the components attached to entity.
+         * @param entity - The entity that you want to destroy.
+         */
+        void destroy(Entity entity);
     
         /**
          * @brief Adds an component to an entity that does not exist in the system.
          * @tparam T - The type that component is.
+         * @tparam Args - The types of args.
          * @param entity - The entity that you want to add it to.
          * @param component - The id of the component.
-         * @param value - The actual data you want to add to entity.
+         * @param args - The arguments passed into the constructor of T, or its members in order if T is an aggregate.
+         * @returns The new component.
          */
-        template<typename T>
-        void addNew(Entity entity, Component component, const T &value);
+        template<typename T, typename ...Args>
+        T &addNew(Entity entity, Component component, Args &&... args);
     
         /**
          * @brief Adds an component to an entity that already exists within the system.
          * @tparam T - The type that component is.
+         * @tparam Args - The types of args.
          * @param entity - The entity that you want to add it to.
          * @param component - The id of the component.
-         * @param value - The actual data you want to add to entity.
+         * @param args - The arguments passed into the constructor of T, or its members in order if T is an aggregate.
+         * @returns The new component.
          */
-        template<typename T>
-        void addOld(Entity entity, Component component, const T &value);
+        template<typename T, typename ...Args>
+        T &addOld(Entity entity, Component component, Args &&... args);
         
         /**
          * @brief Updates an Entity's info based on where its new position is.
@@ -94,6 +160,13 @@ namespace ecs
         template<typename ...Types, typename ...Components>
         void createArchetype(const Components &... components);
         
+        /**
+         * @brief Creates an Archetype with a component that was defined at runtime.
+         * @param id - The Id associated with the layout.
+         * @param layout - How the component is laid out.
+         */
+        void createArchetype(Component id, const ComponentLayout &layout);
+        
         /**
          * @brief Finds an Archetype based on the type you provide.
          * @param type - The type of Archetype you want to find.
@@ -120,6 +193,15 @@ namespace ecs
         template<typename T>
         void cloneArchetype(Component id, const Type &baseType, const Archetype &baseArchetype);
         
+        /**
+         * @brief Performs a shallow copy of the Archetype baseArchetype and then adds id to the type.
+         * @param id - A component (Entity) that was defined at runtime.
+         * @param baseType - The Archetype type that you want to base the new Archetype off of.
+         * @param baseArchetype - The base Archetype that you want to clone (no look-up version).
+         * @param layout - How the component is laid out.
+         */
+        void cloneArchetype(Component id, const Type &baseType, const Archetype &baseArchetype, const ComponentLayout &layout);
+        
         /**
          * @brief Clones an existing archetype but only uses parts of it.
          * @param subType - The new type that you want the new archetype to have.
@@ -133,6 +215,29 @@ namespace ecs
          * @returns All Archetypes with at least the given type.
          */
         [[nodiscard]] std::vector<Archetype*> getArchetypesWithSubset(const UType &uType);
+        
+        /**
+         * @brief Adds any archetypes that match the given type and have been created since cache was last updated.
+         * Does not allocate unless a new archetype matches.
+         * @param uType - The type you want to retrieve. Must be the same every time cache is used.
+         * @param cache - The archetypes that were found last time.
+         */
+        void updateArchetypesWithSubset(const UType &uType, ArchetypeCache &cache);
+        
+        /**
+         * @brief Turns the components and filters of query into bitmasks. Only call once per query.
+         * @param query - The query with its components already set.
+         * @param with - Archetypes must also have all of these, but no columns are given for them.
+         * @param without - Archetypes must have none of these.
+         */
+        void compileQuery(Query &query, const UType &with, const UType &without);
+        
+        /**
+         * @brief Adds any archetypes that match query and have been created since it was last updated. Does not
+         * allocate unless a new archetype matches.
+         * @param query - A query that was compiled with compileQuery().
+         */
+        void updateQuery(Query &query);
     
         /**
          * @brief Gets a reference to a component of type T.
@@ -144,6 +249,14 @@ namespace ecs
         template<typename T>
         [[nodiscard]] T &getComponent(Entity entity, Component component) const;
         
+        /**
+         * @brief Gets the address of a component without knowing its type.
+         * WARNING: Do not store this value for longer than this function is used.
+         * @param entity - The entity that you'd like to query.
+         * @param component - The component Id.
+         */
+        [[nodiscard]] void *getComponentData(Entity entity, Component component) const;
+        
         /**
          * @brief Checks to see if an entity has a component.
          * @param entity - The entity that may have component.
@@ -152,16 +265,149 @@ namespace ecs
          */
         [[nodiscard]] bool hasComponent(Entity entity, Component component) const;
         
+        /**
+         * @param entity - The entity that you're querying for.
+         * @returns True if entity has at least one component.
+         */
+        [[nodiscard]] bool hasAnyComponent(Entity entity) const;
+        
+        /**
+         * @brief Stops (or resumes) entity from being iterated over without moving any of its components. THROWS if the
+         * entity doesn't have any components.
+         * @param entity - The entity that you want to enable or disable.
+         * @param enabled - Whether the entity should be iterated over.
+         */
+        void setEnabled(Entity entity, bool enabled);
+        
+        /**
+         * @param entity - The entity that you're querying for.
+         * @returns False if the entity has been disabled, true otherwise.
+         */
+        [[nodiscard]] bool isEnabled(Entity entity) const;
+        
+        /**
+         * @brief Makes sure that the archetype with type can hold count entities without reallocating. THROWS if the
+         * archetype has not been created yet.
+         * @param type - The type of the archetype.
+         * @param count - The number of entities.
+         */
+        void reserve(const Type &type, uint64_t count);
+        
+        /**
+         * @brief Sets how every archetype grows, except for those given their own policy.
+         * @param policy - The policy that you want to use from now on.
+         */
+        void setGrowthPolicy(const GrowthPolicy &policy);
+        
+        /**
+         * @brief Sets how a single archetype grows. THROWS if the archetype has not been created yet.
+         * @param type - The type of the archetype.
+         * @param policy - The policy that you want to use from now on.
+         */
+        void setGrowthPolicy(const Type &type, const GrowthPolicy &policy);
+        
+        /**
+         * @brief Fills in the archetypes, entity records and archetype map of report.
+         * @param report - The report that you want to add to.
+         */
+        void getMemoryStatistics(MemoryReport &report) const;
+        
+        /**
+         * @brief Fills in the archetypes and transitions of report.
+         * @param report - The report that you want to add to.
+         */
+        void getArchetypeStatistics(ArchetypeReport &report) const;
+        
+        /**
+         * @returns The hardware counters recorded while iterating over each archetype.
+         */
+        [[nodiscard]] std::vector<ArchetypeCounterStatistics> getCounterStatistics() const;
+        
+        /**
+         * @returns The number of entities that have at least one component.
+         */
+        [[nodiscard]] uint64_t getEntityCount() const { return mEntityInformation.size(); }
+        
+        /**
+         * @returns The number of archetypes, including empty ones.
+         */
+        [[nodiscard]] uint64_t getArchetypeCount() const { return mArchetypes.size(); }
+        
+        /**
+         * @returns The bytes reserved by the component arrays of every archetype. Does not allocate.
+         */
+        [[nodiscard]] uint64_t getReservedBytes() const;
+        
     protected:
+        /**
+         * @brief Counts an entity moving from one archetype to another. Does nothing unless built with ECS_ENABLE_PROFILING.
+         * @param from - The archetype the entity was in (nullptr if it didn't have any components).
+         * @param to - The archetype the entity is now in.
+         * @param component - The component that was added or removed.
+         * @param added - True if component was added, false if it was removed.
+         */
+        void recordTransition(const Archetype *from, const Archetype *to, Component component, bool added);
+        
+        /**
+         * @brief Stores a new archetype. Every archetype must be added through here.
+         * @param type - The type of the archetype.
+         * @param archetype - The archetype you want to store.
+         */
+        void insertArchetype(const Type &type, Archetype &&archetype);
+        
+        /**
+         * @brief Gets the bit that represents component in signatures and queries. Assigned the first time it is asked for.
+         * @param component - The component you want the bit of.
+         * @returns The index of the bit. Bits are dense, starting at 0.
+         */
+        uint64_t getComponentBit(Component component);
+        
         // It doesn't like unordered map, Type cannot be converted into a hash function.
         std::map<Type, Archetype> mArchetypes;
         
+        /** Every archetype in the order that they were created. Map iterators stay valid when new items are added. */
+        std::vector<std::map<Type, Archetype>::iterator> mCreationOrder;
+        
+        /** The bits (getComponentBit()) of the components of each archetype, in creation order. */
+        std::vector<std::vector<uint64_t>> mSignatures;
+        
+        std::unordered_map<Component, uint64_t> mComponentBits;
+        
+        /** Given to every new archetype. */
+        GrowthPolicy mGrowthPolicy;
+        
+        /** Archetypes that were given their own growth policy, which the world policy doesn't override. */
+        std::set<Type> mCustomGrowthPolicies;
+        
         /**
          * Tells us where an Entity's information is stored and at what location.
          */
         std::unordered_map<Entity, EntityInformation> mEntityInformation;
+        
+#ifdef ECS_ENABLE_PROFILING
+        struct TransitionCount
+        {
+            Component   component   { 0 };
+            bool        added       { true };
+            uint64_t    count       { 0 };
+        };
+        
+        /** Archetypes never move within mArchetypes, so they can be used as keys. */
+        std::map<std::pair<const Archetype*, const Archetype*>, TransitionCount> mTransitions;
+#endif
     };
     
+    inline void ArchetypeManager::recordTransition([[maybe_unused]] const Archetype *from, [[maybe_unused]] const Archetype *to,
+                                                   [[maybe_unused]] Component component, [[maybe_unused]] bool added)
+    {
+#ifdef ECS_ENABLE_PROFILING
+        TransitionCount &transition = mTransitions[{ from, to }];
+        transition.component = component;
+        transition.added = added;
+        ++transition.count;
+#endif
+    }
+    
     
     template<typename T>
     T &ArchetypeManager::getComponent(Entity entity, Component component) const
@@ -172,27 +418,35 @@ namespace ecs
     }
     
     template<typename T>
-    void ArchetypeManager::add(Entity entity, Component component, const T &value)
+    void ArchetypeManager::add(Entity entity, Component component, T &&value)
     {
-        mEntityInformation.count(entity)
-        ? addOld(entity, component, value)
-        : addNew(entity, component, value);
+        emplace<std::decay_t<T>>(entity, component, std::forward<T>(value));
     }
     
-    template<typename T>
-    void ArchetypeManager::addNew(Entity entity, Component component, const T &value)
+    template<typename T, typename ...Args>
+    T &ArchetypeManager::emplace(Entity entity, Component component, Args &&... args)
+    {
+        return mEntityInformation.count(entity)
+            ? addOld<T>(entity, component, std::forward<Args>(args)...)
+            : addNew<T>(entity, component, std::forward<Args>(args)...);
+    }
+    
+    template<typename T, typename ...Args>
+    T &ArchetypeManager::addNew(Entity entity, Component component, Args &&... args)
     {
         createArchetype<T>(component);
         Archetype * const archetype = findArchetype( { component } );
-        const uint64_t index = archetype->pushBack(component, value);
+        const uint64_t index = archetype->emplaceBack<T>(component, std::forward<Args>(args)...);
+        recordTransition(nullptr, archetype, component, true);
         
         EntityInformation information { { component }, index };
         
         mEntityInformation.insert( { entity, information } );
+        return archetype->getComponent<T>(component, index);
     }
     
-    template<typename T>
-    void ArchetypeManager::addOld(Entity entity, Component component, const T &value)
+    template<typename T, typename ...Args>
+    T &ArchetypeManager::addOld(Entity entity, Component component, Args &&... args)
     {
         EntityInformation &info = mEntityInformation.at(entity);
         Type newType = info.type;
@@ -204,13 +458,63 @@ namespace ecs
         
         Archetype &newArchetype = *findArchetype(newType);  // Again, should never be nullptr.
         
+        // Add in the new item first, since args may refer to the entity's other components which are about to move.
+        // It lands on the same row as the transferred items. Nothing has changed yet if its constructor throws.
+        const uint64_t newIndex = newArchetype.emplaceBack<T>(component, std::forward<Args>(args)...);
+        
         const uint64_t movedIndex = oldArchetype.transferTo(newArchetype, info.componentIndex);
+        recordTransition(&oldArchetype, &newArchetype, component, true);
         
         // Update the moved item's index so that it points to the correct place.
         entityMovedIndex(info.componentIndex, { info.type, movedIndex });
         
-        // Add in the new item.
-        info.componentIndex = newArchetype.pushBack(component, value);
+        info.componentIndex = newIndex;
+        info.type = newType;
+        return newArchetype.getComponent<T>(component, newIndex);
+    }
+    
+    template<typename ...Ts>
+    void ArchetypeManager::add(Entity entity, const std::array<Component, sizeof...(Ts)> &components, Ts &&... values)
+    {
+        const auto it = mEntityInformation.find(entity);
+        Archetype * const oldArchetype = it != mEntityInformation.end() ? findArchetype(it->second.type) : nullptr;
+        
+        Type newType = oldArchetype ? it->second.type : Type { };
+        const uint64_t oldSize = newType.size();
+        newType.insert(components.begin(), components.end());
+        if (newType.size() != oldSize + sizeof...(Ts))
+            throw std::exception();  // The entity already has one of the components, or one was given twice.
+        
+        Archetype *newArchetype = findArchetype(newType);
+        if (!newArchetype)
+        {
+            ECS_TRACE_SCOPE("Create Archetype", "Archetype");
+            Archetype created = oldArchetype ? Archetype(*oldArchetype) : Archetype();
+            uint64_t i = 0;
+            (created.createComponentArray<std::decay_t<Ts>>(components[i++]), ...);
+            insertArchetype(newType, std::move(created));
+            newArchetype = findArchetype(newType);
+        }
+        
+        // Add in the new items first, since values may refer to the entity's other components which are about to move.
+        const uint64_t newIndex = newArchetype->count();
+        uint64_t i = 0;
+        (newArchetype->emplaceBack<std::decay_t<Ts>>(components[i++], std::forward<Ts>(values)), ...);
+        recordTransition(oldArchetype, newArchetype, components.front(), true);  // The report lists all of components.
+        
+        if (!oldArchetype)
+        {
+            mEntityInformation.insert( { entity, { newType, newIndex } } );
+            return;
+        }
+        
+        EntityInformation &info = it->second;
+        const uint64_t movedIndex = oldArchetype->transferTo(*newArchetype, info.componentIndex);
+        
+        // Update the moved item's index so that it points to the correct place.
+        entityMovedIndex(info.componentIndex, { info.type, movedIndex });
+        
+        info.componentIndex = newIndex;
         info.type = newType;
     }
     
@@ -219,10 +523,11 @@ namespace ecs
     {
         if (findArchetype( { id } ))
             return;  // Archetype already exist, no need to make a new one.
-    
+        
+        ECS_TRACE_SCOPE("Create Archetype", "Archetype");
         Archetype archetype;
         archetype.createComponentArray<T>(id);
-        mArchetypes.emplace(Type { id }, std::move(archetype));
+        insertArchetype(Type { id }, std::move(archetype));
     }
     
     template<typename ...Types, typename ...Components>
@@ -230,10 +535,11 @@ namespace ecs
     {
         if (findArchetype( { components... } ))
             return;  // Archetype already exist, no need to make a new one.
-    
+        
+        ECS_TRACE_SCOPE("Create Archetype", "Archetype");
         Archetype archetype;
         archetype.createComponentArray<Types...>(components...);
-        mArchetypes.emplace( Type { components... }, std::move(archetype));
+        insertArchetype(Type { components... }, std::move(archetype));
     }
     
     template<typename T>
@@ -257,10 +563,11 @@ namespace ecs
         if (findArchetype(newType))
             return;  // Archetype already exists.
         
+        ECS_TRACE_SCOPE("Create Archetype", "Archetype");
         Archetype derived(baseArchetype);
         derived.createComponentArray<T>(id);
         
-        mArchetypes.emplace(newType, std::move(derived));
+        insertArchetype(newType, std::move(derived));
     }
 }
 
@@ -0,0 +1,246 @@
+/**
+ * @file ColumnMemory.cpp
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#include "ColumnMemory.h"
+
+#include <algorithm>
+#include <new>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+#define ECS_HAS_VIRTUAL_MEMORY
+#endif
+
+#ifdef __linux__
+#include <cstdio>
+#include <fstream>
+#include <string>
+#endif
+
+namespace ecs
+{
+    namespace
+    {
+        uint64_t roundUp(uint64_t bytes, uint64_t multiple)
+        {
+            return (bytes + multiple - 1) / multiple * multiple;
+        }
+        
+#ifdef ECS_HAS_VIRTUAL_MEMORY
+        uint64_t roundToPage(uint64_t bytes)
+        {
+            static const uint64_t pageSize = sysconf(_SC_PAGESIZE);
+            return roundUp(bytes, pageSize);
+        }
+        
+        /**
+         * @brief Maps bytes so that the first byte is aligned to alignment, by over-mapping and trimming both ends.
+         * @returns The start of the mapping, or nullptr if it could not be mapped.
+         */
+        std::byte *mapAligned(uint64_t bytes, uint64_t alignment, int protection, int flags)
+        {
+            const uint64_t padded = bytes + alignment;
+            void *address = mmap(nullptr, padded, protection, MAP_PRIVATE | MAP_ANONYMOUS | flags, -1, 0);
+            if (address == MAP_FAILED)
+                return nullptr;
+            
+            auto * const start = static_cast<std::byte*>(address);
+            auto * const aligned = reinterpret_cast<std::byte*>(roundUp(reinterpret_cast<uintptr_t>(start), alignment));
+            if (aligned != start)
+                munmap(start, aligned - start);
+            if (aligned + bytes != start + padded)
+                munmap(aligned + bytes, start + padded - (aligned + bytes));
+            return aligned;
+        }
+        
+        /**
+         * @brief Asks the kernel to back a range with transparent huge pages. It may still refuse.
+         */
+        void adviseHugePages(std::byte *address, uint64_t bytes)
+        {
+#ifdef MADV_HUGEPAGE
+            madvise(address, bytes, MADV_HUGEPAGE);
+#endif
+        }
+#endif
+    }
+    
+    ColumnMemory ColumnMemory::allocate(uint64_t bytes, uint64_t alignment, bool hugePages)
+    {
+        ColumnMemory memory;
+#ifdef ECS_HAS_VIRTUAL_MEMORY
+        if (hugePages && bytes >= hugePageSize)
+        {
+            const uint64_t mapped = roundUp(bytes, hugePageSize);
+#ifdef MAP_HUGETLB
+            // Explicit huge pages only exist when the administrator has set some aside (vm.nr_hugepages).
+            void *address = mmap(nullptr, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (address != MAP_FAILED)
+            {
+                memory.mData = static_cast<std::byte*>(address);
+                memory.mHugePages = HugePages::Explicit;
+            }
+#endif
+            if (!memory.mData)
+            {
+                memory.mData = mapAligned(mapped, hugePageSize, PROT_READ | PROT_WRITE, 0);
+                if (!memory.mData)
+                    throw std::bad_alloc();
+                adviseHugePages(memory.mData, mapped);
+                memory.mHugePages = HugePages::Transparent;
+            }
+            memory.mSize = bytes;
+            memory.mMapped = mapped;
+            return memory;
+        }
+#endif
+        memory.mData = static_cast<std::byte*>(::operator new(bytes, std::align_val_t(alignment)));
+        memory.mSize = bytes;
+        memory.mAlignment = alignment;
+        return memory;
+    }
+    
+    ColumnMemory ColumnMemory::reserve(uint64_t bytes, bool hugePages)
+    {
+        ColumnMemory memory;
+#ifdef ECS_HAS_VIRTUAL_MEMORY
+        bytes = hugePages ? roundUp(bytes, hugePageSize) : roundToPage(bytes);
+        std::byte *address = hugePages
+            ? mapAligned(bytes, hugePageSize, PROT_NONE, MAP_NORESERVE)
+            : static_cast<std::byte*>(mmap(nullptr, bytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0));
+        if (!address || address == MAP_FAILED)
+            return memory;  // Out of address space. The caller falls back to the heap.
+        
+        // The advice stays with the range as it is committed.
+        if (hugePages)
+        {
+            adviseHugePages(address, bytes);
+            memory.mHugePages = HugePages::Transparent;
+        }
+        memory.mData = address;
+        memory.mReserved = bytes;
+        memory.mMapped = bytes;
+#endif
+        return memory;
+    }
+    
+    ColumnMemory::ColumnMemory(ColumnMemory &&other) noexcept
+        : mData(std::exchange(other.mData, nullptr)), mSize(std::exchange(other.mSize, 0)),
+          mReserved(std::exchange(other.mReserved, 0)), mMapped(std::exchange(other.mMapped, 0)),
+          mAlignment(std::exchange(other.mAlignment, 0)), mHugePages(std::exchange(other.mHugePages, HugePages::None))
+    {
+    
+    }
+    
+    ColumnMemory &ColumnMemory::operator=(ColumnMemory &&other) noexcept
+    {
+        if (this == &other)
+            return *this;
+        release();
+        mData = std::exchange(other.mData, nullptr);
+        mSize = std::exchange(other.mSize, 0);
+        mReserved = std::exchange(other.mReserved, 0);
+        mMapped = std::exchange(other.mMapped, 0);
+        mAlignment = std::exchange(other.mAlignment, 0);
+        mHugePages = std::exchange(other.mHugePages, HugePages::None);
+        return *this;
+    }
+    
+    ColumnMemory::~ColumnMemory()
+    {
+        release();
+    }
+    
+    bool ColumnMemory::commit(uint64_t bytes)
+    {
+        if (bytes <= mSize)
+            return true;
+#ifdef ECS_HAS_VIRTUAL_MEMORY
+        if (!isReserved() || bytes > mReserved)
+            return false;
+        
+        // Only the new pages are touched, so growing never copies anything. Committing whole huge pages stops the
+        // kernel from having to split them.
+        bytes = mHugePages != HugePages::None ? roundUp(bytes, hugePageSize) : roundToPage(bytes);
+        if (mprotect(mData + mSize, bytes - mSize, PROT_READ | PROT_WRITE) != 0)
+            return false;
+        mSize = bytes;
+        return true;
+#else
+        return false;
+#endif
+    }
+    
+    uint64_t ColumnMemory::getHugePageBytes(const HugePageMap &hugePages) const
+    {
+        if (mHugePages == HugePages::Explicit)
+            return mMapped;
+        if (mHugePages == HugePages::Transparent)
+            return hugePages.getBytesWithin(mData, mMapped);
+        return 0;
+    }
+    
+    HugePageMap HugePageMap::read()
+    {
+        HugePageMap hugePageMap;
+#ifdef __linux__
+        std::ifstream smaps("/proc/self/smaps");
+        std::string line;
+        Mapping mapping;
+        while (std::getline(smaps, line))
+        {
+            unsigned long start = 0;
+            unsigned long finish = 0;
+            unsigned long kiloBytes = 0;
+            if (std::sscanf(line.c_str(), "%lx-%lx ", &start, &finish) == 2)
+                mapping = { start, finish, 0 };
+            else if (std::sscanf(line.c_str(), "AnonHugePages: %lu kB", &kiloBytes) == 1 && kiloBytes != 0)
+                hugePageMap.mMappings.push_back({ mapping.begin, mapping.end, kiloBytes * 1024 });
+        }
+#endif
+        return hugePageMap;
+    }
+    
+    uint64_t HugePageMap::getBytesWithin(const void *data, uint64_t size) const
+    {
+        const auto begin = reinterpret_cast<uintptr_t>(data);
+        const uintptr_t end = begin + size;
+        
+        // The first mapping that ends after the range starts.
+        auto it = std::upper_bound(mMappings.begin(), mMappings.end(), begin, [](uintptr_t address, const Mapping &mapping) {
+            return address < mapping.end;
+        });
+        
+        uint64_t bytes = 0;
+        for (; it != mMappings.end() && it->begin < end; ++it)
+        {
+            const uint64_t overlap = std::min(end, it->end) - std::max(begin, it->begin);
+            const double share = static_cast<double>(overlap) / static_cast<double>(it->end - it->begin);
+            bytes += std::min(overlap, static_cast<uint64_t>(static_cast<double>(it->hugePageBytes) * share));
+        }
+        return bytes;
+    }
+    
+    void ColumnMemory::release()
+    {
+        if (!mData)
+            return;
+#ifdef ECS_HAS_VIRTUAL_MEMORY
+        if (mMapped != 0)
+            munmap(mData, mMapped);
+        else
+#endif
+            ::operator delete(mData, std::align_val_t(mAlignment));
+        mData = nullptr;
+        mSize = 0;
+        mReserved = 0;
+        mMapped = 0;
+        mHugePages = HugePages::None;
+    }
+}
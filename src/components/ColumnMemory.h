@@ -0,0 +1,135 @@
+/**
+ * @file ColumnMemory.h
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ecs
+{
+    /**
+     * @brief How many bytes of each mapping in the process are backed by transparent huge pages. Read once from
+     * /proc/self/smaps (Linux only) and then shared by every column in a report.
+     * @author Ryan Purse
+     * @date 17/10/2026
+     */
+    class HugePageMap
+    {
+    public:
+        /**
+         * @brief Reads /proc/self/smaps. Slow, so only read it once per report.
+         * @returns Every mapping that has huge pages. Empty on other platforms.
+         */
+        [[nodiscard]] static HugePageMap read();
+        
+        /**
+         * @brief The kernel merges neighbouring mappings, so one mapping can hold several columns. The huge pages of
+         * a mapping are split between the columns by how much of it each one overlaps, so nothing is counted twice.
+         * @param data - The start of the range.
+         * @param size - The number of bytes in the range.
+         * @returns The bytes within the range that are backed by huge pages.
+         */
+        [[nodiscard]] uint64_t getBytesWithin(const void *data, uint64_t size) const;
+        
+    protected:
+        struct Mapping
+        {
+            uintptr_t   begin           { 0 };
+            uintptr_t   end             { 0 };
+            uint64_t    hugePageBytes   { 0 };
+        };
+        
+        /** Sorted by address, as they are in smaps. */
+        std::vector<Mapping> mMappings;
+    };
+    
+    /**
+     * @brief The raw bytes behind a component array. Either an ordinary heap allocation, or a range of address space
+     * that is reserved up front and committed as it grows so that it never moves (see GrowthPolicy::reservedRows).
+     * @author Ryan Purse
+     * @date 17/10/2026
+     */
+    class ColumnMemory
+    {
+    public:
+        /** The size of the huge pages that are asked for. */
+        static constexpr uint64_t hugePageSize { 2ull * 1024 * 1024 };
+        
+        ColumnMemory() = default;
+        
+        /**
+         * @brief Allocates bytes from the heap.
+         * @param bytes - The number of bytes.
+         * @param alignment - Must be a power of two.
+         * @param hugePages - Maps the memory with huge pages instead when there's at least one huge page worth. Tries
+         * MAP_HUGETLB first, then falls back to transparent huge pages (MADV_HUGEPAGE).
+         */
+        [[nodiscard]] static ColumnMemory allocate(uint64_t bytes, uint64_t alignment, bool hugePages=false);
+        
+        /**
+         * @brief Reserves address space for bytes without committing any of it. Aligned to a page.
+         * @param bytes - The most that can ever be committed.
+         * @param hugePages - Aligns the reservation to a huge page and asks for transparent huge pages
+         * (MADV_HUGEPAGE). Memory is then committed a huge page at a time.
+         * @returns Empty memory (isReserved() is false) if address space can't be reserved on this platform.
+         */
+        [[nodiscard]] static ColumnMemory reserve(uint64_t bytes, bool hugePages=false);
+        
+        ColumnMemory(ColumnMemory &&other) noexcept;
+        ColumnMemory &operator=(ColumnMemory &&other) noexcept;
+        
+        ColumnMemory(const ColumnMemory &) = delete;
+        ColumnMemory &operator=(const ColumnMemory &) = delete;
+        
+        ~ColumnMemory();
+        
+        /**
+         * @brief Makes at least bytes usable without moving. Only committed pages use any memory.
+         * @param bytes - The number of bytes that need to be usable.
+         * @returns False if this is not reserved or bytes don't fit within the reservation. Nothing changes.
+         */
+        bool commit(uint64_t bytes);
+        
+        [[nodiscard]] std::byte *data() const { return mData; }
+        
+        /**
+         * @returns The number of bytes that can be used right now.
+         */
+        [[nodiscard]] uint64_t size() const { return mSize; }
+        
+        /**
+         * @returns The size of the reservation, or 0 if this is a heap allocation.
+         */
+        [[nodiscard]] uint64_t getReservedBytes() const { return mReserved; }
+        
+        [[nodiscard]] bool isReserved() const { return mReserved != 0; }
+        
+        /**
+         * @brief Finds out how much of this memory is actually backed by huge pages.
+         * @param hugePages - Where transparent huge pages are. Read it once and pass it to every column.
+         * @returns The number of bytes backed by huge pages. Always 0 unless huge pages were asked for.
+         */
+        [[nodiscard]] uint64_t getHugePageBytes(const HugePageMap &hugePages) const;
+        
+    protected:
+        /** How the memory was mapped when huge pages were asked for. */
+        enum class HugePages : uint8_t { None, Explicit, Transparent };
+        
+        void release();
+        
+        std::byte   *mData      { nullptr };
+        uint64_t    mSize       { 0 };
+        uint64_t    mReserved   { 0 };
+        
+        /** The size of the mapping when it wasn't allocated from the heap. */
+        uint64_t    mMapped     { 0 };
+        uint64_t    mAlignment  { 0 };
+        HugePages   mHugePages  { HugePages::None };
+    };
+}
@@ -0,0 +1,216 @@
+/**
+ * @file ColumnStorage.h
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#pragma once
+
+#include "ColumnMemory.h"
+#include "GrowthPolicy.h"
+
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace ecs
+{
+    /**
+     * @brief A contiguous array of T, like std::vector, that grows with a GrowthPolicy. When the policy reserves
+     * address space, growing commits new pages in place instead of moving every element.
+     * @tparam T - The type of each element.
+     * @author Ryan Purse
+     * @date 17/10/2026
+     */
+    template<typename T>
+    class ColumnStorage
+    {
+    public:
+        ColumnStorage() = default;
+        
+        ColumnStorage(const ColumnStorage &) = delete;
+        ColumnStorage &operator=(const ColumnStorage &) = delete;
+        
+        ~ColumnStorage();
+        
+        [[nodiscard]] T &operator[](uint64_t index) const { return data()[index]; }
+        
+        [[nodiscard]] T *data() const { return reinterpret_cast<T*>(mMemory.data()); }
+        
+        [[nodiscard]] T *begin() const { return data(); }
+        
+        [[nodiscard]] T *end() const { return data() + mSize; }
+        
+        [[nodiscard]] T &back() const { return data()[mSize - 1]; }
+        
+        [[nodiscard]] uint64_t size() const { return mSize; }
+        
+        [[nodiscard]] uint64_t capacity() const { return mCapacity; }
+        
+        [[nodiscard]] bool empty() const { return mSize == 0; }
+        
+        /**
+         * @returns True if the elements are within reserved address space, so growing never moves them.
+         */
+        [[nodiscard]] bool isStable() const { return mMemory.isReserved(); }
+        
+        /**
+         * @returns The bytes backed by huge pages. See ColumnMemory::getHugePageBytes().
+         */
+        [[nodiscard]] uint64_t getHugePageBytes(const HugePageMap &hugePages) const
+        {
+            return mMemory.getHugePageBytes(hugePages);
+        }
+        
+        /**
+         * @brief Constructs an element at the end. args may refer to another element of this array. Aggregates
+         * (C style structs) are brace-initialised from args when T has no matching constructor.
+         * @returns The new element.
+         */
+        template<typename ...Args>
+        T &emplace_back(Args &&...args);
+        
+        /**
+         * @brief Destroys the last element.
+         */
+        void pop_back();
+        
+        /**
+         * @brief Makes sure that exactly capacity elements can be stored without growing again. Never shrinks.
+         * @param capacity - The number of elements.
+         */
+        void reserve(uint64_t capacity);
+        
+        /**
+         * @brief Sets how the array grows from now on. Moves every element once if the policy reserves address space
+         * and the elements are not within a reservation of that size yet.
+         * @param policy - The policy that you want to use.
+         */
+        void setGrowthPolicy(const GrowthPolicy &policy);
+        
+    protected:
+        /**
+         * @brief Constructs a T at address. Uses T(args...) if T has a matching constructor, T { args... } otherwise.
+         * @returns The new element.
+         */
+        template<typename ...Args>
+        static T *construct(void *address, Args &&...args);
+        
+        /**
+         * @brief Moves every element into memory and then uses it. memory must be able to hold all of them.
+         * @param memory - The memory you want to use from now on.
+         */
+        void relocate(ColumnMemory &&memory);
+        
+        ColumnMemory    mMemory;
+        uint64_t        mSize       { 0 };
+        uint64_t        mCapacity   { 0 };
+        GrowthPolicy    mGrowthPolicy;
+    };
+    
+    template<typename T>
+    ColumnStorage<T>::~ColumnStorage()
+    {
+        std::destroy_n(data(), mSize);
+    }
+    
+    template<typename T>
+    template<typename ...Args>
+    T &ColumnStorage<T>::emplace_back(Args &&...args)
+    {
+        if (mSize == mCapacity)
+        {
+            const uint64_t capacity = mGrowthPolicy.grow(mCapacity, mSize + 1);
+            if (mMemory.commit(capacity * sizeof(T)))
+            {
+                mCapacity = mMemory.size() / sizeof(T);
+            }
+            else
+            {
+                // The new element is made before the others move, since args may refer to one of them.
+                ColumnMemory memory = ColumnMemory::allocate(capacity * sizeof(T), alignof(T), mGrowthPolicy.hugePages);
+                T *element = construct(memory.data() + mSize * sizeof(T), std::forward<Args>(args)...);
+                try
+                {
+                    relocate(std::move(memory));
+                }
+                catch (...)
+                {
+                    element->~T();
+                    throw;
+                }
+                mCapacity = capacity;
+                ++mSize;
+                return *element;
+            }
+        }
+        
+        T *element = construct(data() + mSize, std::forward<Args>(args)...);
+        ++mSize;
+        return *element;
+    }
+    
+    template<typename T>
+    template<typename ...Args>
+    T *ColumnStorage<T>::construct(void *address, Args &&...args)
+    {
+        if constexpr (std::is_constructible_v<T, Args...>)
+            return new (address) T(std::forward<Args>(args)...);
+        else
+            return new (address) T { std::forward<Args>(args)... };
+    }
+    
+    template<typename T>
+    void ColumnStorage<T>::pop_back()
+    {
+        --mSize;
+        std::destroy_at(data() + mSize);
+    }
+    
+    template<typename T>
+    void ColumnStorage<T>::reserve(uint64_t capacity)
+    {
+        if (capacity <= mCapacity)
+            return;
+        
+        if (!mMemory.commit(capacity * sizeof(T)))
+        {
+            relocate(ColumnMemory::allocate(capacity * sizeof(T), alignof(T), mGrowthPolicy.hugePages));
+            mCapacity = capacity;
+            return;
+        }
+        mCapacity = mMemory.size() / sizeof(T);
+    }
+    
+    template<typename T>
+    void ColumnStorage<T>::setGrowthPolicy(const GrowthPolicy &policy)
+    {
+        mGrowthPolicy = policy;
+        
+        const uint64_t reservedBytes = policy.reservedRows * sizeof(T);
+        if (policy.reservedRows < mCapacity || mMemory.getReservedBytes() >= reservedBytes)
+            return;  // The elements wouldn't fit, or they're already reserved.
+        
+        ColumnMemory memory = ColumnMemory::reserve(reservedBytes, policy.hugePages);
+        if (!memory.commit(mCapacity * sizeof(T)))
+            return;  // Address space can't be reserved, so stay on the heap.
+        
+        relocate(std::move(memory));
+        mCapacity = mMemory.size() / sizeof(T);
+    }
+    
+    template<typename T>
+    void ColumnStorage<T>::relocate(ColumnMemory &&memory)
+    {
+        T * const destination = reinterpret_cast<T*>(memory.data());
+        if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>)
+            std::uninitialized_move_n(data(), mSize, destination);
+        else
+            std::uninitialized_copy_n(data(), mSize, destination);
+        
+        std::destroy_n(data(), mSize);
+        mMemory = std::move(memory);
+    }
+}
@@ -7,9 +7,11 @@
 
 #pragma once
 
+#include "ColumnStorage.h"
+#include "GrowthPolicy.h"
+
 #include <iostream>
 #include <memory>
-#include <vector>
 
 namespace ecs
 {
@@ -40,7 +42,40 @@ namespace ecs
         
         virtual void moveLastItem(uint64_t itemIndex) = 0;
         
-        [[nodiscard]] virtual uint64_t count() = 0;
+        [[nodiscard]] virtual uint64_t count() const = 0;
+        
+        /**
+         * @returns The number of elements that can be stored before the array needs to reallocate.
+         */
+        [[nodiscard]] virtual uint64_t capacity() const = 0;
+        
+        /**
+         * @brief Makes sure that capacity elements can be stored without reallocating. Never shrinks the array.
+         * @param capacity - The number of elements.
+         */
+        virtual void reserve(uint64_t capacity) = 0;
+        
+        /**
+         * @brief Sets how the array grows when it runs out of room.
+         * @param policy - The policy that you want to use from now on.
+         */
+        virtual void setGrowthPolicy(const GrowthPolicy &policy) = 0;
+        
+        /**
+         * @returns The size in bytes of a single element, including padding. Element i is at rawData() + i * elementSize().
+         */
+        [[nodiscard]] virtual uint64_t elementSize() const = 0;
+        
+        /**
+         * @returns The first element. Invalidated when the array grows.
+         */
+        [[nodiscard]] virtual void *rawData() = 0;
+        
+        /**
+         * @param hugePages - Where transparent huge pages are. Read once per report.
+         * @returns The bytes that are backed by huge pages (see GrowthPolicy::hugePages).
+         */
+        [[nodiscard]] virtual uint64_t getHugePageBytes(const HugePageMap &hugePages) const = 0;
     };
     
     /**
@@ -80,9 +115,37 @@ namespace ecs
         /**
          * @returns The number elements in data.
          */
-        uint64_t count() override;
+        [[nodiscard]] uint64_t count() const override;
+        
+        /**
+         * @returns The number of elements that data can hold before it reallocates.
+         */
+        [[nodiscard]] uint64_t capacity() const override;
+        
+        /**
+         * @brief Reserves exactly capacity elements within data.
+         * @param capacity - The number of elements.
+         */
+        void reserve(uint64_t capacity) override;
+        
+        void setGrowthPolicy(const GrowthPolicy &policy) override;
+        
+        /**
+         * @returns sizeof(T).
+         */
+        [[nodiscard]] uint64_t elementSize() const override;
+        
+        /**
+         * @returns data.data().
+         */
+        [[nodiscard]] void *rawData() override;
+        
+        /**
+         * @returns data.getHugePageBytes().
+         */
+        [[nodiscard]] uint64_t getHugePageBytes(const HugePageMap &hugePages) const override;
     
-        std::vector<T> data;
+        ColumnStorage<T> data;
     };
     
     
@@ -96,25 +159,64 @@ namespace ecs
     uint64_t ComponentArray<T>::transferItemTo(IComponentArray *newComponentArray, uint64_t itemIndex)
     {
         // This may not throw an error when reinterpreting. Make sure that both component arrays are the same type.
-        std::vector<T> &newData = reinterpret_cast<ComponentArray<T>*>(newComponentArray)->data;
+        ColumnStorage<T> &newData = reinterpret_cast<ComponentArray<T>*>(newComponentArray)->data;
         newData.emplace_back(std::move(data[itemIndex]));
     
         // Minimises the impact on the number of indices change to reduce overhead.
-        std::iter_swap(data.begin() + itemIndex, data.end() - 1);
-        data.erase(data.end() - 1);
+        if (itemIndex != data.size() - 1)
+            data[itemIndex] = std::move(data.back());
+        data.pop_back();
         return data.size();
     }
     
     template<typename T>
     void ComponentArray<T>::moveLastItem(uint64_t itemIndex)
     {
-        data[itemIndex] = data[data.size() - 1];
-        data.erase(data.end() - 1);
+        // Moving an item onto itself would leave it in a moved-from state.
+        if (itemIndex != data.size() - 1)
+            data[itemIndex] = std::move(data.back());
+        data.pop_back();
     }
     
     template<typename T>
-    uint64_t ComponentArray<T>::count()
+    uint64_t ComponentArray<T>::count() const
     {
         return data.size();
     }
+    
+    template<typename T>
+    uint64_t ComponentArray<T>::capacity() const
+    {
+        return data.capacity();
+    }
+    
+    template<typename T>
+    void ComponentArray<T>::reserve(uint64_t capacity)
+    {
+        data.reserve(capacity);
+    }
+    
+    template<typename T>
+    void ComponentArray<T>::setGrowthPolicy(const GrowthPolicy &policy)
+    {
+        data.setGrowthPolicy(policy);
+    }
+    
+    template<typename T>
+    uint64_t ComponentArray<T>::elementSize() const
+    {
+        return sizeof(T);
+    }
+    
+    template<typename T>
+    uint64_t ComponentArray<T>::getHugePageBytes(const HugePageMap &hugePages) const
+    {
+        return data.getHugePageBytes(hugePages);
+    }
+    
+    template<typename T>
+    void *ComponentArray<T>::rawData()
+    {
+        return data.data();
+    }
 }
@@ -0,0 +1,132 @@
+/**
+ * @file DynamicComponentArray.cpp
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#include "DynamicComponentArray.h"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <utility>
+
+namespace ecs
+{
+    DynamicComponentArray::DynamicComponentArray(const ComponentLayout &layout)
+        : mLayout(layout), mStride(std::max<uint64_t>(1, (layout.size + layout.alignment - 1) / layout.alignment * layout.alignment))
+    {
+
+    }
+
+    DynamicComponentArray::~DynamicComponentArray()
+    {
+        if (mLayout.destruct)
+        {
+            for (uint64_t i = 0; i < mCount; ++i)
+                mLayout.destruct(at(i));
+        }
+    }
+
+    std::unique_ptr<IComponentArray> DynamicComponentArray::makeArray()
+    {
+        return std::make_unique<DynamicComponentArray>(mLayout);
+    }
+
+    uint64_t DynamicComponentArray::transferItemTo(IComponentArray *newComponentArray, uint64_t itemIndex)
+    {
+        // This may not throw an error when casting. Make sure that both component arrays have the same layout.
+        auto *newArray = static_cast<DynamicComponentArray*>(newComponentArray);
+
+        // The item is relocated rather than copied, so it is not destructed here.
+        if (newArray->mCount == newArray->mCapacity)
+            newArray->grow(1);
+        std::memcpy(newArray->at(newArray->mCount++), at(itemIndex), mLayout.size);
+
+        --mCount;
+        if (itemIndex != mCount)
+            std::memcpy(at(itemIndex), at(mCount), mLayout.size);
+        return mCount;
+    }
+
+    void DynamicComponentArray::moveLastItem(uint64_t itemIndex)
+    {
+        if (mLayout.destruct)
+            mLayout.destruct(at(itemIndex));
+
+        --mCount;
+        if (itemIndex != mCount)
+            std::memcpy(at(itemIndex), at(mCount), mLayout.size);
+    }
+
+    uint64_t DynamicComponentArray::pushBack(const void *value)
+    {
+        if (mCount == mCapacity)
+            grow(1);
+
+        std::byte * const item = at(mCount);
+        if (value)
+            std::memcpy(item, value, mLayout.size);
+        else if (mLayout.construct)
+            mLayout.construct(item);
+        else
+            std::memset(item, 0, mStride);
+
+        return mCount++;
+    }
+
+    uint64_t DynamicComponentArray::pushBack(const void *values, uint64_t count)
+    {
+        if (mCount + count > mCapacity)
+            grow(count);
+
+        const uint64_t first = mCount;
+        const auto * const bytes = static_cast<const std::byte*>(values);
+        for (uint64_t i = 0; i < count; ++i)
+            pushBack(bytes ? bytes + i * mLayout.size : nullptr);
+        return first;
+    }
+
+    void DynamicComponentArray::reserve(uint64_t capacity)
+    {
+        if (capacity <= mCapacity)
+            return;
+        
+        if (!mMemory.commit(capacity * mStride))
+        {
+            relocate(ColumnMemory::allocate(capacity * mStride, mLayout.alignment, mGrowthPolicy.hugePages));
+            mCapacity = capacity;
+            return;
+        }
+        mCapacity = mMemory.size() / mStride;
+    }
+
+    void DynamicComponentArray::setGrowthPolicy(const GrowthPolicy &policy)
+    {
+        mGrowthPolicy = policy;
+        
+        const uint64_t reservedBytes = policy.reservedRows * mStride;
+        if (policy.reservedRows < mCapacity || mMemory.getReservedBytes() >= reservedBytes)
+            return;  // The components wouldn't fit, or they're already reserved.
+        
+        ColumnMemory memory = ColumnMemory::reserve(reservedBytes, policy.hugePages);
+        if (!memory.commit(mCapacity * mStride))
+            return;  // Address space can't be reserved, so stay on the heap.
+        
+        relocate(std::move(memory));
+        mCapacity = mMemory.size() / mStride;
+    }
+
+    void DynamicComponentArray::grow(uint64_t count)
+    {
+        reserve(mGrowthPolicy.grow(mCapacity, mCount + count));
+    }
+
+    void DynamicComponentArray::relocate(ColumnMemory &&memory)
+    {
+        if (mCount != 0)
+            std::memcpy(memory.data(), mMemory.data(), mCount * mStride);
+        mMemory = std::move(memory);
+    }
+}
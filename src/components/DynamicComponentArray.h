@@ -0,0 +1,128 @@
+/**
+ * @file DynamicComponentArray.h
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#pragma once
+
+#include "ComponentArray.h"
+#include "ComponentLayout.h"
+#include "ColumnMemory.h"
+
+namespace ecs
+{
+    /**
+     * @brief Holds every component of a type that was defined at runtime (see ComponentLayout) as raw, aligned bytes.
+     * Behaves the same as ComponentArray<T> otherwise, so both can be stored within the same archetype.
+     * @author Ryan Purse
+     * @date 17/10/2026
+     */
+    class DynamicComponentArray
+            : public IComponentArray
+    {
+    public:
+        /**
+         * @param layout - How each component is laid out. Must outlive this array.
+         */
+        explicit DynamicComponentArray(const ComponentLayout &layout);
+
+        DynamicComponentArray(const DynamicComponentArray &) = delete;
+        DynamicComponentArray &operator=(const DynamicComponentArray &) = delete;
+
+        ~DynamicComponentArray() override;
+
+        /**
+         * @brief Creates an empty array with the same layout.
+         * @returns An interface to the component array.
+         */
+        [[nodiscard]] std::unique_ptr<IComponentArray> makeArray() override;
+
+        /**
+         * @brief Moves items from this component array to the new component array. Both array MUST have the same layout.
+         * @param newComponentArray - The array that you want to move the item to.
+         * @param itemIndex - The index of the item you want to move.
+         * @returns The number of elements left in this array.
+         */
+        [[nodiscard]] uint64_t transferItemTo(IComponentArray *newComponentArray, uint64_t itemIndex) override;
+
+        /**
+         * @brief Destructs the item at itemIndex and moves the last item into it.
+         * @param itemIndex - The index that you want to move it to.
+         */
+        void moveLastItem(uint64_t itemIndex) override;
+
+        /**
+         * @brief Adds a component to the end of the array.
+         * @param value - The bytes that are copied into the new component. It is constructed (or zeroed) if nullptr.
+         * @returns The index of the new component.
+         */
+        uint64_t pushBack(const void *value);
+
+        /**
+         * @brief Adds count components to the end of the array.
+         * @param values - count components packed layout.size bytes apart. They are constructed (or zeroed) if nullptr.
+         * @param count - The number of components to add.
+         * @returns The index of the first new component.
+         */
+        uint64_t pushBack(const void *values, uint64_t count);
+
+        /**
+         * @brief Makes sure that exactly capacity components can be stored without growing again.
+         * @param capacity - The number of components.
+         */
+        void reserve(uint64_t capacity) override;
+        
+        /**
+         * @brief Sets how the array grows from now on. Moves every component once if the policy reserves address space
+         * and the components are not within a reservation of that size yet.
+         * @param policy - The policy that you want to use.
+         */
+        void setGrowthPolicy(const GrowthPolicy &policy) override;
+
+        [[nodiscard]] uint64_t count() const override { return mCount; }
+
+        [[nodiscard]] uint64_t capacity() const override { return mCapacity; }
+
+        /**
+         * @returns The size of the layout rounded up to its alignment.
+         */
+        [[nodiscard]] uint64_t elementSize() const override { return mStride; }
+
+        [[nodiscard]] void *rawData() override { return mMemory.data(); }
+
+        [[nodiscard]] uint64_t getHugePageBytes(const HugePageMap &hugePages) const override
+        {
+            return mMemory.getHugePageBytes(hugePages);
+        }
+
+        [[nodiscard]] const ComponentLayout &getLayout() const { return mLayout; }
+
+    protected:
+        /**
+         * @returns The address of the item at index.
+         */
+        [[nodiscard]] std::byte *at(uint64_t index) const { return mMemory.data() + index * mStride; }
+
+        /**
+         * @brief Makes room for count more items with the growth policy.
+         * @param count - The number of items that are about to be added.
+         */
+        void grow(uint64_t count);
+
+        /**
+         * @brief Moves every item into memory and then uses it. Items are moved byte by byte.
+         * @param memory - Must be able to hold mCount items.
+         */
+        void relocate(ColumnMemory &&memory);
+
+        const ComponentLayout   &mLayout;
+        const uint64_t          mStride;
+
+        ColumnMemory    mMemory;
+        uint64_t        mCount      { 0 };
+        uint64_t        mCapacity   { 0 };
+        GrowthPolicy    mGrowthPolicy;
+    };
+}
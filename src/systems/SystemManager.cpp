@@ -7,6 +7,9 @@
 
 #include "SystemManager.h"
 #include "Entities.h"
+#include "TraceRecorder.h"
+#include "PerfCounters.h"
+#include "AllocationCounter.h"
 
 namespace ecs
 {
@@ -42,64 +45,124 @@ namespace ecs
     
     void SystemManager::fixedUpdate()
     {
-        for (const auto &[system, uType] : mPreFixedUpdateSystems)
-        {
-            system->onUpdate();
-            const auto iEntities = system->getEntities();
-            iEntities->callbackProcessEntities(uType);
-        }
-    
-        for (const auto &[system, uType] : mFixedUpdateSystems)
-        {
-            system->onUpdate();
-            const auto iEntities = system->getEntities();
-            iEntities->callbackProcessEntities(uType);
-        }
+        updateSystems(mPreFixedUpdateSystems);
+        updateSystems(mFixedUpdateSystems);
     }
     
     void SystemManager::update()
     {
-        for (const auto &[system, uType] : mPreUpdateSystems)
-        {
-            system->onUpdate();
-            const auto iEntities = system->getEntities();
-            iEntities->callbackProcessEntities(uType);
-        }
-    
-        for (const auto &[system, uType] : mUpdateSystems)
-        {
-            system->onUpdate();
-            const auto iEntities = system->getEntities();
-            iEntities->callbackProcessEntities(uType);
-        }
+        updateSystems(mPreUpdateSystems);
+        updateSystems(mUpdateSystems);
     }
     
     void SystemManager::render()
     {
-        for (const auto &[system, uType] : mPreRenderSystems)
-        {
-            system->onUpdate();
-            const auto iEntities = system->getEntities();
-            iEntities->callbackProcessEntities(uType);
-        }
+        updateSystems(mPreRenderSystems);
+        updateSystems(mRenderSystems);
+    }
+    
+    void SystemManager::imGui()
+    {
+        updateSystems(mImGuiSystems);
+    }
     
-        for (const auto &[system, uType] : mRenderSystems)
+    void SystemManager::updateSystems(std::vector<SystemUTypePair> &systems)
+    {
+        for (SystemUTypePair &pair : systems)
         {
-            system->onUpdate();
-            const auto iEntities = system->getEntities();
-            iEntities->callbackProcessEntities(uType);
+            ECS_TRACE_SCOPE_ID("System", "System", reinterpret_cast<uintptr_t>(pair.system.get()));
+            const ScratchScope scratchScope(*mScratch);
+#ifdef ECS_ENABLE_PROFILING
+            using Clock = std::chrono::steady_clock;
+            
+#ifdef ECS_ENABLE_PERF_COUNTERS
+            const HardwareCounters countersBefore = PerfCounters::read();
+#endif
+#ifdef ECS_ENABLE_ALLOCATION_COUNTING
+            const AllocationCounts allocationsBefore = AllocationCounter::read();
+#endif
+            const auto start = Clock::now();
+            pair.system->onUpdate();
+            const auto updated = Clock::now();
+            const ProcessStatistics processed = pair.system->getEntities()->callbackProcessEntities(pair.uType);
+            const auto end = Clock::now();
+            
+            SystemFrameStatistics frame;
+            frame.onUpdateTime = updated - start;
+            frame.iterationTime = end - updated;
+            frame.entityCount = processed.entityCount;
+            frame.archetypeCount = processed.archetypeCount;
+#ifdef ECS_ENABLE_PERF_COUNTERS
+            frame.counters = PerfCounters::read() - countersBefore;
+#endif
+#ifdef ECS_ENABLE_ALLOCATION_COUNTING
+            frame.allocations = AllocationCounter::read() - allocationsBefore;
+#endif
+            pair.profile.record(frame);
+            pair.latency.record(end - start);
+#else
+            pair.system->onUpdate();
+            const auto iEntities = pair.system->getEntities();
+            iEntities->callbackProcessEntities(pair.uType);
+#endif
         }
     }
     
-    void SystemManager::imGui()
+    std::vector<SystemStatistics> SystemManager::getStatistics() const
     {
-        for (const auto &[system, uType] : mImGuiSystems)
+        std::vector<SystemStatistics> out;
+#ifdef ECS_ENABLE_PROFILING
+        appendStatistics(mPreFixedUpdateSystems, out);
+        appendStatistics(mFixedUpdateSystems, out);
+        appendStatistics(mPreUpdateSystems, out);
+        appendStatistics(mUpdateSystems, out);
+        appendStatistics(mPreRenderSystems, out);
+        appendStatistics(mRenderSystems, out);
+        appendStatistics(mImGuiSystems, out);
+#endif
+        return out;
+    }
+    
+    void SystemManager::appendStatistics([[maybe_unused]] const std::vector<SystemUTypePair> &systems,
+                                         [[maybe_unused]] std::vector<SystemStatistics> &out)
+    {
+#ifdef ECS_ENABLE_PROFILING
+        for (const SystemUTypePair &pair : systems)
+            out.push_back({ pair.system.get(), pair.system->getExecutionOrder(), pair.profile.getFrames(), pair.latency.getPercentiles() });
+#endif
+    }
+    
+    uint32_t SystemManager::getLatestFrames([[maybe_unused]] SharedSystemFrame *out, [[maybe_unused]] uint32_t maxCount) const
+    {
+        uint32_t count = 0;
+#ifdef ECS_ENABLE_PROFILING
+        appendLatestFrames(mPreFixedUpdateSystems, out, maxCount, count);
+        appendLatestFrames(mFixedUpdateSystems, out, maxCount, count);
+        appendLatestFrames(mPreUpdateSystems, out, maxCount, count);
+        appendLatestFrames(mUpdateSystems, out, maxCount, count);
+        appendLatestFrames(mPreRenderSystems, out, maxCount, count);
+        appendLatestFrames(mRenderSystems, out, maxCount, count);
+        appendLatestFrames(mImGuiSystems, out, maxCount, count);
+#endif
+        return count;
+    }
+    
+    void SystemManager::appendLatestFrames([[maybe_unused]] const std::vector<SystemUTypePair> &systems,
+                                           [[maybe_unused]] SharedSystemFrame *out, [[maybe_unused]] uint32_t maxCount,
+                                           [[maybe_unused]] uint32_t &count)
+    {
+#ifdef ECS_ENABLE_PROFILING
+        for (const SystemUTypePair &pair : systems)
         {
-            system->onUpdate();
-            const auto iEntities = system->getEntities();
-            iEntities->callbackProcessEntities(uType);
+            if (count >= maxCount)
+                return;
+            
+            const SystemFrameStatistics &frame = pair.profile.getLatestFrame();
+            out[count++] = {
+                reinterpret_cast<uintptr_t>(pair.system.get()), pair.system->getExecutionOrder(),
+                frame.onUpdateTime.count(), frame.iterationTime.count(), frame.entityCount, frame.archetypeCount
+            };
         }
+#endif
     }
 }
-
-
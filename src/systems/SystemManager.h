@@ -8,9 +8,15 @@
 #pragma once
 
 #include "BaseSystem.h"
+#include "Statistics.h"
+#include "SystemProfile.h"
+#include "LatencyHistogram.h"
+#include "SharedStats.h"
+#include "ScratchAllocator.h"
 
 #include <vector>
 #include <memory>
+#include <utility>
 
 namespace ecs
 {
@@ -23,8 +29,15 @@ namespace ecs
     {
         struct SystemUTypePair
         {
+            SystemUTypePair(std::unique_ptr<IBaseSystem> system, UType uType)
+                : system(std::move(system)), uType(std::move(uType)) {}
+            
             std::unique_ptr<IBaseSystem>    system;
             UType                           uType;
+#ifdef ECS_ENABLE_PROFILING
+            SystemProfile                   profile;
+            LatencyHistogram                latency;
+#endif
         };
         
     public:
@@ -54,8 +67,47 @@ namespace ecs
          * @brief Renders all ImGui related systems assigned to this system manager.
          */
         void imGui();
+        
+        /**
+         * @brief Gets the recorded history of every system. Empty unless built with ECS_ENABLE_PROFILING.
+         * @returns The statistics of each system in the order that they are updated.
+         */
+        [[nodiscard]] std::vector<SystemStatistics> getStatistics() const;
+        
+        /**
+         * @brief Copies the most recent frame of each system into out. Does not allocate.
+         * Always returns 0 unless built with ECS_ENABLE_PROFILING.
+         * @param out - Where to write each system's frame.
+         * @param maxCount - The number of systems that fit in out. Any more systems are skipped.
+         * @returns The number of systems written to out.
+         */
+        uint32_t getLatestFrames(SharedSystemFrame *out, uint32_t maxCount) const;
+        
+        /**
+         * @brief Sets the arena that is rewound after each system is updated, so that systems can't use up each
+         * other's scratch memory.
+         * @param scratch - The scratch arena of the thread that updates the systems. Must not be nullptr.
+         */
+        void setScratch(ScratchArena *scratch) { mScratch = scratch; }
 
     protected:
+        /**
+         * @brief Calls onUpdate() and then processes the entities of each system in systems.
+         * @param systems - The systems that you want to update.
+         */
+        void updateSystems(std::vector<SystemUTypePair> &systems);
+        
+        /**
+         * @brief Appends the statistics of each system in systems to out.
+         */
+        static void appendStatistics(const std::vector<SystemUTypePair> &systems, std::vector<SystemStatistics> &out);
+        
+        /**
+         * @brief Copies the most recent frame of each system in systems into out, starting at count.
+         */
+        static void appendLatestFrames(const std::vector<SystemUTypePair> &systems, SharedSystemFrame *out, uint32_t maxCount, uint32_t &count);
+        
+
         std::vector<SystemUTypePair> mPreFixedUpdateSystems;
         std::vector<SystemUTypePair> mFixedUpdateSystems;
         std::vector<SystemUTypePair> mPreUpdateSystems;
@@ -63,6 +115,8 @@ namespace ecs
         std::vector<SystemUTypePair> mPreRenderSystems;
         std::vector<SystemUTypePair> mRenderSystems;
         std::vector<SystemUTypePair> mImGuiSystems;
+        
+        ScratchArena *mScratch { nullptr };
     };
 }
 
@@ -0,0 +1,72 @@
+/**
+ * @file SystemProfile.h
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#pragma once
+
+#include "Statistics.h"
+
+#include <algorithm>
+#include <array>
+
+#ifndef ECS_PROFILER_FRAME_COUNT
+#define ECS_PROFILER_FRAME_COUNT 128
+#endif
+
+namespace ecs
+{
+    /**
+     * @brief A ring buffer of the last ECS_PROFILER_FRAME_COUNT frames of a single system.
+     * Never allocates while recording.
+     * @author Ryan Purse
+     * @date 17/10/2026
+     */
+    class SystemProfile
+    {
+    public:
+        /**
+         * @brief Records a frame. Overwrites the oldest frame once the buffer is full.
+         * @param frame - The statistics of the frame that just happened.
+         */
+        void record(const SystemFrameStatistics &frame);
+
+        /**
+         * @returns All of the recorded frames with the oldest frame first.
+         */
+        [[nodiscard]] std::vector<SystemFrameStatistics> getFrames() const;
+
+        /**
+         * @returns The most recent frame. Zeroed if nothing has been recorded.
+         */
+        [[nodiscard]] const SystemFrameStatistics &getLatestFrame() const;
+
+    protected:
+        std::array<SystemFrameStatistics, ECS_PROFILER_FRAME_COUNT> mFrames;
+        uint64_t mFrameCount { 0 };
+    };
+
+    inline void SystemProfile::record(const SystemFrameStatistics &frame)
+    {
+        mFrames[mFrameCount++ % mFrames.size()] = frame;
+    }
+
+    inline const SystemFrameStatistics &SystemProfile::getLatestFrame() const
+    {
+        return mFrames[(mFrameCount + mFrames.size() - 1) % mFrames.size()];
+    }
+
+    inline std::vector<SystemFrameStatistics> SystemProfile::getFrames() const
+    {
+        const uint64_t count = std::min<uint64_t>(mFrameCount, mFrames.size());
+        const uint64_t first = mFrameCount - count;
+
+        std::vector<SystemFrameStatistics> out;
+        out.reserve(count);
+        for (uint64_t i = first; i < mFrameCount; ++i)
+            out.push_back(mFrames[i % mFrames.size()]);
+        return out;
+    }
+}
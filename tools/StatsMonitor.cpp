@@ -0,0 +1,178 @@
+/**
+ * @file StatsMonitor.cpp Tails the stats published by Core::startStatsExport() from another process.
+ * Usage: EntityComponentSystem2022StatsMonitor [name] [--interval 100] [--systems]
+ * @author Ryan Purse
+ * @date 17/10/2026
+ */
+
+
+#include "SharedStats.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+
+namespace
+{
+    struct Settings
+    {
+        std::string name            { "/ecs-stats" };
+        uint64_t    intervalMs      { 100 };
+        bool        systems         { false };
+    };
+
+    /**
+     * @brief A copy of a SharedFrame that is safe to read once the seqlock has been checked.
+     */
+    struct FrameCopy
+    {
+        uint64_t frame { 0 };
+        int64_t  phaseTimes[ecs::phase::Count] {};
+        uint64_t entityCount { 0 };
+        uint64_t archetypeCount { 0 };
+        uint64_t componentBytes { 0 };
+        uint32_t systemCount { 0 };
+        ecs::SharedSystemFrame systems[ECS_SHARED_STATS_MAX_SYSTEMS] {};
+    };
+
+    /**
+     * @brief Copies a frame using the seqlock protocol.
+     * @returns False if the writer changed the frame while it was being copied or is still writing it.
+     */
+    bool tryCopy(const ecs::SharedFrame &frame, FrameCopy &out)
+    {
+        const uint64_t before = frame.sequence.load(std::memory_order_acquire);
+        if (before % 2 == 1)
+            return false;  // Being written.
+
+        out.frame = frame.frame;
+        std::memcpy(out.phaseTimes, frame.phaseTimes, sizeof(out.phaseTimes));
+        out.entityCount = frame.entityCount;
+        out.archetypeCount = frame.archetypeCount;
+        out.componentBytes = frame.componentBytes;
+        out.systemCount = std::min<uint32_t>(frame.systemCount, ECS_SHARED_STATS_MAX_SYSTEMS);
+        std::memcpy(out.systems, frame.systems, sizeof(ecs::SharedSystemFrame) * out.systemCount);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return frame.sequence.load(std::memory_order_relaxed) == before;
+    }
+
+    double toMs(int64_t nanoseconds)
+    {
+        return static_cast<double>(nanoseconds) / 1'000'000.0;
+    }
+
+    void print(const FrameCopy &frame, bool systems)
+    {
+        std::printf("frame %llu  fixed %.3fms  update %.3fms  render %.3fms  imgui %.3fms  entities %llu  archetypes %llu  components %.1fKiB\n",
+                    static_cast<unsigned long long>(frame.frame),
+                    toMs(frame.phaseTimes[ecs::phase::FixedUpdate]), toMs(frame.phaseTimes[ecs::phase::Update]),
+                    toMs(frame.phaseTimes[ecs::phase::Render]), toMs(frame.phaseTimes[ecs::phase::ImGui]),
+                    static_cast<unsigned long long>(frame.entityCount),
+                    static_cast<unsigned long long>(frame.archetypeCount),
+                    static_cast<double>(frame.componentBytes) / 1024.0);
+
+        if (!systems)
+            return;
+
+        for (uint32_t i = 0; i < frame.systemCount; ++i)
+        {
+            const ecs::SharedSystemFrame &system = frame.systems[i];
+            std::printf("    system %#llx  order %u  onUpdate %.3fms  iteration %.3fms  entities %llu  archetypes %llu\n",
+                        static_cast<unsigned long long>(system.id), system.executionOrder,
+                        toMs(system.onUpdateTime), toMs(system.iterationTime),
+                        static_cast<unsigned long long>(system.entityCount),
+                        static_cast<unsigned long long>(system.archetypeCount));
+        }
+    }
+
+    Settings parse(int argc, char *argv[])
+    {
+        Settings settings;
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string argument = argv[i];
+            if (argument == "--interval" && i + 1 < argc)
+                settings.intervalMs = std::max<uint64_t>(1, std::stoull(argv[++i]));
+            else if (argument == "--systems")
+                settings.systems = true;
+            else if (argument.rfind("--", 0) != 0)
+                settings.name = argument;
+            else
+            {
+                std::fprintf(stderr, "Usage: %s [name] [--interval 100] [--systems]\n", argv[0]);
+                std::exit(1);
+            }
+        }
+        return settings;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    const Settings settings = parse(argc, argv);
+
+    const int descriptor = shm_open(settings.name.c_str(), O_RDONLY, 0);
+    if (descriptor == -1)
+    {
+        std::fprintf(stderr, "Unable to open %s. Has Core::startStatsExport() been called?\n", settings.name.c_str());
+        return 1;
+    }
+
+    void *memory = mmap(nullptr, sizeof(ecs::SharedStats), PROT_READ, MAP_SHARED, descriptor, 0);
+    close(descriptor);
+    if (memory == MAP_FAILED)
+    {
+        std::fprintf(stderr, "Unable to map %s.\n", settings.name.c_str());
+        return 1;
+    }
+
+    const auto &stats = *static_cast<const ecs::SharedStats*>(memory);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (std::memcmp(stats.magic, "ECSSTATS", sizeof(stats.magic)) != 0
+        || stats.version != ecs::sharedStatsVersion
+        || stats.slotCount != ECS_SHARED_STATS_SLOT_COUNT
+        || stats.maxSystems != ECS_SHARED_STATS_MAX_SYSTEMS
+        || stats.frameSize != sizeof(ecs::SharedFrame))
+    {
+        std::fprintf(stderr, "%s was made by a different version of the ecs.\n", settings.name.c_str());
+        return 1;
+    }
+
+    uint64_t printed = stats.frameCount.load(std::memory_order_acquire);
+    FrameCopy copy;
+    while (true)
+    {
+        const uint64_t latest = stats.frameCount.load(std::memory_order_acquire);
+
+        // Frames older than the ring buffer have already been overwritten.
+        if (latest - printed > ECS_SHARED_STATS_SLOT_COUNT)
+        {
+            std::printf("(skipped %llu frames)\n", static_cast<unsigned long long>(latest - printed - ECS_SHARED_STATS_SLOT_COUNT));
+            printed = latest - ECS_SHARED_STATS_SLOT_COUNT;
+        }
+
+        for (; printed < latest; ++printed)
+        {
+            const ecs::SharedFrame &frame = stats.frames[printed % ECS_SHARED_STATS_SLOT_COUNT];
+
+            // The writer never waits, so a frame may be overwritten while it is copied. Skip it if that keeps happening.
+            bool copied = false;
+            for (int attempt = 0; attempt < 8 && !copied; ++attempt)
+                copied = tryCopy(frame, copy) && copy.frame == printed + 1;
+            if (copied)
+                print(copy, settings.systems);
+        }
+
+        std::fflush(stdout);
+        std::this_thread::sleep_for(std::chrono::milliseconds(settings.intervalMs));
+    }
+}